@@ -0,0 +1,122 @@
+// bench_batch.c
+// L2a gate submission: one l2a_* call per gate vs l2a_execute_batch, in
+// the evaluation loop checkpoint, run a candidate sequence, restore
+// (fast recording and copy-on-write checkpoints on). Then l2b_OR
+// expansions batched and JIT-compiled, with and without the peephole pass.
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_enhanced.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#define QUBITS 64
+#define CANDIDATES 100000
+
+static void run_gates(L2a_Runtime* r, const R_Cell* cells, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        R_Cell c = cells[i];
+        switch (c.gate) {
+            case 0: l2a_CCNOT(r, c.a, c.b, c.c); break;
+            case 1: l2a_CNOT(r, c.a, c.b); break;
+            case 2: l2a_NOT(r, c.a); break;
+            case 3: l2a_SWAP(r, c.a, c.b); break;
+        }
+    }
+}
+
+typedef enum { RUN_GATES, RUN_BATCH, RUN_JIT } Run_Mode;
+
+// Average time per candidate in seconds
+static double measure(Qubit_Backend_Type backend, const R_Cell* cells, uint32_t len,
+                      Run_Mode mode, bool optimize, uint32_t* checksum) {
+    L2a_Runtime* r = l2a_init(QUBITS, 0, backend);
+    l2a_set_fast_record(r, true);
+    l2a_set_cow_checkpoints(r, true);
+    l2a_set_optimize(r, optimize);
+    if (mode == RUN_JIT) l2a_set_jit(r, 4);
+
+    double start = bench_now();
+    for (uint32_t i = 0; i < CANDIDATES; i++) {
+        uint32_t cp = l2a_checkpoint(r);
+        if (mode == RUN_BATCH) l2a_execute_batch(r, cells, len);
+        else if (mode == RUN_JIT) l2a_jit_run(r, cells, len);
+        else run_gates(r, cells, len);
+        *checksum = *checksum * 31 + qubit_read(r->qubit_state, i % QUBITS);
+        l2a_restore(r, cp);
+    }
+    double elapsed = bench_now() - start;
+
+    l2a_free(r);
+    return elapsed / CANDIDATES;
+}
+
+int main(void) {
+    R_Cell cells[64];
+    uint32_t seed = 0x51ED27u;
+    for (uint32_t i = 0; i < 64; i++) {
+        uint8_t gate = bench_rand(&seed) % 4;
+        uint8_t a = bench_rand(&seed) % QUBITS;
+        uint8_t b = (a + 1 + bench_rand(&seed) % (QUBITS - 1)) % QUBITS;
+        uint8_t c = (b + 1) % QUBITS == a ? (b + 2) % QUBITS : (b + 1) % QUBITS;
+        cells[i] = (R_Cell){gate, a, gate == 2 ? 0 : b, gate == 0 ? c : 0};
+    }
+
+    const struct { Qubit_Backend_Type type; const char* name; } backends[] = {
+        {QUBIT_BACKEND_CLASSICAL, "classical"},
+        {QUBIT_BACKEND_PACKED, "packed"},
+    };
+    const uint32_t lengths[] = {8, 16, 64};
+
+    printf("Candidate evaluation (checkpoint + sequence + restore), %d qubits, ns/candidate\n",
+           QUBITS);
+    printf("%-10s %6s %12s %12s %8s\n", "backend", "gates", "per-gate", "batch", "speedup");
+
+    uint32_t checksum = 0;
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++) {
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            double gates = measure(backends[b].type, cells, lengths[l], RUN_GATES, false, &checksum);
+            double batch = measure(backends[b].type, cells, lengths[l], RUN_BATCH, false, &checksum);
+            printf("%-10s %6u %12.1f %12.1f %7.2fx\n", backends[b].name, lengths[l],
+                   gates * 1e9, batch * 1e9, gates / batch);
+        }
+    }
+
+    // OR chains: each l2b_OR is NOT a, NOT b, CCNOT a b t, NOT t, NOT a, NOT b,
+    // so consecutive ORs over the same inputs leave four NOTs to cancel
+    R_Cell ors[64];
+    for (uint32_t k = 0; k < 10; k++) {
+        uint8_t a = 2 * (k / 5), b = a + 1, t = 10 + k;
+        R_Cell* o = &ors[k * 6];
+        o[0] = (R_Cell){2, a, 0, 0};
+        o[1] = (R_Cell){2, b, 0, 0};
+        o[2] = (R_Cell){0, a, b, t};
+        o[3] = (R_Cell){2, t, 0, 0};
+        o[4] = (R_Cell){2, a, 0, 0};
+        o[5] = (R_Cell){2, b, 0, 0};
+    }
+    R_Cell copy[64];
+    memcpy(copy, ors, sizeof(ors));
+    L2a_Opt_Stats stats;
+    l2a_optimize(copy, 60, &stats);
+
+    // The pass runs on every batch but only once per JIT compile
+    printf("\nOR chain (10 x l2b_OR, %llu -> %llu gates), ns/candidate\n",
+           (unsigned long long)stats.input_gates, (unsigned long long)stats.output_gates);
+    printf("%-10s %10s %10s %10s %10s\n", "backend", "batch", "batch+opt", "jit", "jit+opt");
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++) {
+        printf("%-10s", backends[b].name);
+        for (uint32_t m = 0; m < 4; m++) {
+            double t = measure(backends[b].type, ors, 60, m < 2 ? RUN_BATCH : RUN_JIT, m & 1,
+                               &checksum);
+            printf(" %10.1f", t * 1e9);
+        }
+        printf("\n");
+    }
+    printf("(checksum %08x)\n", checksum);
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+// bench_circuit.c
+// 16-bit ripple-carry adder on the packed backend, evaluated repeatedly:
+// one l2b_* call per op (direct mode, recorded) vs the compiled circuit as
+// a threaded program vs the compiled circuit through the JIT.
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_enhanced.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdint.h>
+
+#define BITS 16
+#define QUBITS 128
+#define EVALS 200000
+
+// a on qubits [0, 16), b on [16, 32), sum on [32, 49)
+#define A(i) (uint8_t)(i)
+#define B(i) (uint8_t)(BITS + (i))
+#define SUM(i) (uint8_t)(2 * BITS + (i))
+#define ANCILLA 64
+
+// The same adder as hand-written calls, temporaries at fixed qubits
+static void adder_calls(L2b_Runtime* r) {
+    const uint8_t half = ANCILLA, both = ANCILLA + 1, carry = ANCILLA + 2, prop = ANCILLA + 3;
+    l2b_XOR(r, A(0), B(0), SUM(0));
+    l2b_AND(r, A(0), B(0), carry);
+    for (uint32_t i = 1; i < BITS; i++) {
+        l2b_XOR(r, A(i), B(i), half);
+        l2b_AND(r, A(i), B(i), both);
+        l2b_XOR(r, half, carry, SUM(i));
+        l2b_AND(r, half, carry, prop);
+        l2b_OR(r, both, prop, carry);
+    }
+    l2b_OR(r, carry, carry, SUM(BITS));
+}
+
+static L2b_Circuit* adder_circuit(void) {
+    L2b_Circuit* c = l2b_circuit_create();
+    L2b_Wire carry = 0;
+    for (uint32_t i = 0; i < BITS; i++) {
+        L2b_Wire a = l2b_circuit_input(c, A(i));
+        L2b_Wire b = l2b_circuit_input(c, B(i));
+        L2b_Wire half = l2b_circuit_gate(c, L2B_OP_XOR, a, b);
+        L2b_Wire both = l2b_circuit_gate(c, L2B_OP_AND, a, b);
+        if (i == 0) {
+            l2b_circuit_output(c, half, SUM(0));
+            carry = both;
+            continue;
+        }
+        l2b_circuit_output(c, l2b_circuit_gate(c, L2B_OP_XOR, half, carry), SUM(i));
+        L2b_Wire prop = l2b_circuit_gate(c, L2B_OP_AND, half, carry);
+        carry = l2b_circuit_gate(c, L2B_OP_OR, both, prop);
+    }
+    l2b_circuit_output(c, carry, SUM(BITS));
+    l2b_circuit_compile(c, ANCILLA, QUBITS - ANCILLA);
+    return c;
+}
+
+typedef enum { RUN_CALLS, RUN_PROGRAM, RUN_JIT } Run_Mode;
+
+// Average time per evaluation in seconds
+static double measure(L2b_Circuit* c, Run_Mode mode, uint32_t* checksum) {
+    L2a_Runtime* l2a = l2a_init(QUBITS, 0, QUBIT_BACKEND_PACKED);
+    L2b_Runtime* l2b = l2b_init(l2a);
+    l2a_set_fast_record(l2a, true);
+    l2b_set_direct(l2b, true);
+    if (mode == RUN_JIT) l2a_set_jit(l2a, 4);
+
+    uint32_t seed = 0xADDu;
+    double start = bench_now();
+    for (uint32_t i = 0; i < EVALS; i++) {
+        // New operands every 64 evaluations
+        if ((i & 63) == 0) {
+            uint32_t v = bench_rand(&seed);
+            for (uint32_t q = 0; q < 2 * BITS; q++) {
+                if (qubit_read(l2a->qubit_state, (uint8_t)q) != ((v >> q) & 1)) {
+                    qubit_NOT(l2a->qubit_state, (uint8_t)q);
+                }
+            }
+        }
+        if (mode == RUN_CALLS) adder_calls(l2b);
+        else l2b_circuit_run(l2b, c);
+        *checksum = *checksum * 31 + qubit_read(l2a->qubit_state, SUM(i % (BITS + 1)));
+    }
+    double elapsed = bench_now() - start;
+
+    l2b_free(l2b);
+    l2a_free(l2a);
+    return elapsed / EVALS;
+}
+
+int main(void) {
+    L2b_Circuit* c = adder_circuit();
+    printf("%d-bit adder, packed backend: %u cells, %u ancillas\n", BITS, c->cell_count,
+           c->ancillas_used);
+    printf("%-22s %12s %14s\n", "mode", "ns/eval", "evals/s");
+
+    const struct { Run_Mode mode; const char* name; } modes[] = {
+        {RUN_CALLS, "l2b_* calls (direct)"},
+        {RUN_PROGRAM, "circuit, threaded"},
+        {RUN_JIT, "circuit, JIT"},
+    };
+    uint32_t checksum = 0;
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        double t = measure(c, modes[m].mode, &checksum);
+        printf("%-22s %12.1f %14.0f\n", modes[m].name, t * 1e9, 1.0 / t);
+    }
+    printf("(checksum %08x)\n", checksum);
+
+    l2b_circuit_free(c);
+    return 0;
+}
@@ -0,0 +1,100 @@
+// bench_dispatch.c
+// Gate dispatch microbenchmark: gates/sec through
+//   1. registry lookup per gate (get_backend_ops + null checks, the old path)
+//   2. the ops table cached in Qubit_State
+//   3. the inline qubit_* fast path
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_quantum_ready.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define STREAM_LEN 4096
+#define PASSES 2000
+
+typedef struct {
+    uint8_t gate, a, b, c;
+} Gate;
+
+static Gate stream[STREAM_LEN];
+
+// The pre-cache dispatch: resolve the table and null-check on every gate
+static void registry_gate(Qubit_State* s, Gate g) {
+    const Qubit_Backend_Ops* ops = get_backend_ops(s->backend_type);
+    switch (g.gate) {
+        case 0: if (ops && ops->CCNOT) ops->CCNOT(s, g.a, g.b, g.c); break;
+        case 1: if (ops && ops->CNOT) ops->CNOT(s, g.a, g.b); break;
+        case 2: if (ops && ops->NOT) ops->NOT(s, g.a); break;
+        case 3: if (ops && ops->SWAP) ops->SWAP(s, g.a, g.b); break;
+    }
+}
+
+static void cached_gate(Qubit_State* s, Gate g) {
+    switch (g.gate) {
+        case 0: s->ops->CCNOT(s, g.a, g.b, g.c); break;
+        case 1: s->ops->CNOT(s, g.a, g.b); break;
+        case 2: s->ops->NOT(s, g.a); break;
+        case 3: s->ops->SWAP(s, g.a, g.b); break;
+    }
+}
+
+static void inline_gate(Qubit_State* s, Gate g) {
+    switch (g.gate) {
+        case 0: qubit_CCNOT(s, g.a, g.b, g.c); break;
+        case 1: qubit_CNOT(s, g.a, g.b); break;
+        case 2: qubit_NOT(s, g.a); break;
+        case 3: qubit_SWAP(s, g.a, g.b); break;
+    }
+}
+
+static double run(Qubit_Backend_Type backend, void (*apply)(Qubit_State*, Gate),
+                  uint32_t* checksum) {
+    Qubit_State* s = qubit_init(64, backend);
+    double start = bench_now();
+    for (int p = 0; p < PASSES; p++) {
+        for (int i = 0; i < STREAM_LEN; i++) {
+            apply(s, stream[i]);
+        }
+    }
+    double elapsed = bench_now() - start;
+    for (uint8_t q = 0; q < 64; q++) {
+        *checksum = *checksum * 31 + qubit_read(s, q);
+    }
+    qubit_free(s);
+    return (double)STREAM_LEN * PASSES / elapsed;
+}
+
+int main(void) {
+    uint32_t seed = 0x9E3779B9u;
+    for (int i = 0; i < STREAM_LEN; i++) {
+        stream[i].gate = bench_rand(&seed) % 4;
+        stream[i].a = bench_rand(&seed) % 64;
+        stream[i].b = bench_rand(&seed) % 64;
+        stream[i].c = bench_rand(&seed) % 64;
+    }
+
+    const struct { Qubit_Backend_Type type; const char* name; } backends[] = {
+        {QUBIT_BACKEND_CLASSICAL, "classical"},
+        {QUBIT_BACKEND_PACKED, "packed"},
+        {QUBIT_BACKEND_BITSLICED, "bitsliced"},
+    };
+
+    printf("Gate dispatch throughput (%d gates x %d passes, Mgates/s)\n",
+           STREAM_LEN, PASSES);
+    printf("%-10s %12s %12s %12s %8s\n", "backend", "registry", "cached-ops", "inline", "speedup");
+
+    uint32_t checksum = 0;
+    for (size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); i++) {
+        double before = run(backends[i].type, registry_gate, &checksum);
+        double cached = run(backends[i].type, cached_gate, &checksum);
+        double after = run(backends[i].type, inline_gate, &checksum);
+        printf("%-10s %12.1f %12.1f %12.1f %7.2fx\n", backends[i].name,
+               before / 1e6, cached / 1e6, after / 1e6, after / before);
+    }
+    printf("(checksum %08x)\n", checksum);
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+// bench_fusion.c
+// Statevector simulator, 20 qubits: gate-by-gate sweeps vs fused runs
+// (one permutation sweep per run of gates over at most SIM_FUSE_QUBITS
+// qubits) for a few typical gate mixes.
+// Needs -DENABLE_QUANTUM_SIMULATOR.
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_quantum_ready.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef ENABLE_QUANTUM_SIMULATOR
+
+#define QUBITS 20
+#define GATES 240
+
+typedef enum { MIX_RANDOM, MIX_LOCAL, MIX_OR } Gate_Mix;
+
+// Fill gates[] with GATES gates of the given mix
+static void make_mix(Gate_Mix mix, Sim_Gate* gates) {
+    uint32_t seed = 0xF05Eu + mix;
+    for (uint32_t i = 0; i < GATES; i++) {
+        uint8_t a, b, c;
+        if (mix == MIX_LOCAL) {
+            // Adder-like: operands within a window sliding across the register
+            uint8_t base = (uint8_t)((i / 24) * 2 % (QUBITS - 5));
+            a = base + bench_rand(&seed) % 6;
+            b = base + (a - base + 1 + bench_rand(&seed) % 5) % 6;
+            c = base + (b - base + 1) % 6 == a ? base + (b - base + 2) % 6 : base + (b - base + 1) % 6;
+        } else {
+            a = bench_rand(&seed) % QUBITS;
+            b = (a + 1 + bench_rand(&seed) % (QUBITS - 1)) % QUBITS;
+            c = (b + 1) % QUBITS == a ? (b + 2) % QUBITS : (b + 1) % QUBITS;
+        }
+
+        if (mix == MIX_OR) {
+            // l2b_OR expansion: NOT a, NOT b, CCNOT a b c, NOT c, NOT a, NOT b
+            const Sim_Gate expansion[6] = {{2, a, 0, 0}, {2, b, 0, 0}, {0, a, b, c},
+                                           {2, c, 0, 0}, {2, a, 0, 0}, {2, b, 0, 0}};
+            for (uint32_t k = 0; k < 6 && i < GATES; k++) gates[i++] = expansion[k];
+            i--;
+        } else {
+            uint8_t kind = bench_rand(&seed) % 4;
+            gates[i] = (Sim_Gate){kind, a, b, c};
+        }
+    }
+}
+
+// Average time per gate in seconds; *sweeps gets the sweep count
+static double measure(const Sim_Gate* gates, bool fusion, uint64_t* sweeps) {
+    Qubit_State* state = qubit_init(QUBITS, QUBIT_BACKEND_SIMULATOR);
+    quantum_simulator_set_fusion(state, fusion);
+
+    double start = bench_now();
+    for (uint32_t i = 0; i < GATES; i++) {
+        Sim_Gate g = gates[i];
+        switch (g.gate) {
+            case 0: qubit_CCNOT(state, g.a, g.b, g.c); break;
+            case 1: qubit_CNOT(state, g.a, g.b); break;
+            case 2: qubit_NOT(state, g.a); break;
+            case 3: qubit_SWAP(state, g.a, g.b); break;
+        }
+    }
+    quantum_simulator_flush(state);
+    double elapsed = bench_now() - start;
+
+    *sweeps = ((Quantum_Simulator_State*)state->backend_data)->sweeps;
+    qubit_free(state);
+    return elapsed / GATES;
+}
+
+int main(void) {
+    const struct { Gate_Mix mix; const char* name; } mixes[] = {
+        {MIX_RANDOM, "random"},
+        {MIX_LOCAL, "local window"},
+        {MIX_OR, "l2b_OR chains"},
+    };
+
+    printf("Statevector simulator, %d qubits, %d gates per mix, us/gate\n", QUBITS, GATES);
+    printf("%-14s %10s %10s %12s %8s\n", "mix", "unfused", "fused", "gates/sweep", "speedup");
+    for (size_t m = 0; m < sizeof(mixes) / sizeof(mixes[0]); m++) {
+        Sim_Gate gates[GATES];
+        make_mix(mixes[m].mix, gates);
+        uint64_t plain_sweeps = 0, fused_sweeps = 0;
+        double plain = measure(gates, false, &plain_sweeps);
+        double fused = measure(gates, true, &fused_sweeps);
+        printf("%-14s %10.1f %10.1f %12.1f %7.1fx\n", mixes[m].name, plain * 1e6, fused * 1e6,
+               (double)GATES / (double)(fused_sweeps ? fused_sweeps : 1), plain / fused);
+    }
+    return 0;
+}
+
+#else
+
+int main(void) {
+    printf("bench_fusion: build with -DENABLE_QUANTUM_SIMULATOR\n");
+    return 0;
+}
+
+#endif
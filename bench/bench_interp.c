@@ -0,0 +1,90 @@
+// bench_interp.c
+// Stored-program execution: switch loop over R_Cell with the inline
+// qubit_* gates (the l2a_restore replay loop, run forward) vs the
+// pre-decoded direct-threaded program interpreter. Programs are random
+// gate streams of several lengths, each run to the same total gate count;
+// past the indirect-branch predictor's reach (a few thousand gates here)
+// every dispatch mispredicts and the switch loop wins.
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_enhanced.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdint.h>
+
+#define MAX_PROGRAM_LEN 4096
+#define TOTAL_GATES (1u << 23)
+#define QUBITS 64
+
+static R_Cell program[MAX_PROGRAM_LEN];
+
+static void switch_loop(Qubit_State* s, const R_Cell* cells, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        R_Cell c = cells[i];
+        switch (c.gate) {
+            case 0: qubit_CCNOT(s, c.a, c.b, c.c); break;
+            case 1: qubit_CNOT(s, c.a, c.b); break;
+            case 2: qubit_NOT(s, c.a); break;
+            case 3: qubit_SWAP(s, c.a, c.b); break;
+        }
+    }
+}
+
+// Mgates/s
+static double run(Qubit_Backend_Type backend, uint32_t len, bool threaded,
+                  uint32_t* checksum) {
+    Qubit_State* s = qubit_init(QUBITS, backend);
+    L2a_Program* p = l2a_program_compile(program, len, backend);
+
+    double start = bench_now();
+    for (uint32_t pass = 0; pass < TOTAL_GATES / len; pass++) {
+        if (threaded) l2a_program_run(p, s);
+        else switch_loop(s, program, len);
+    }
+    double elapsed = bench_now() - start;
+
+    for (uint8_t q = 0; q < QUBITS; q++) {
+        *checksum = *checksum * 31 + qubit_read(s, q);
+    }
+    l2a_program_free(p);
+    qubit_free(s);
+    return (double)TOTAL_GATES / elapsed / 1e6;
+}
+
+int main(void) {
+    uint32_t seed = 0x2545F491u;
+    for (int i = 0; i < MAX_PROGRAM_LEN; i++) {
+        program[i].gate = bench_rand(&seed) % 4;
+        program[i].a = bench_rand(&seed) % QUBITS;
+        program[i].b = bench_rand(&seed) % QUBITS;
+        program[i].c = bench_rand(&seed) % QUBITS;
+    }
+
+    const struct { Qubit_Backend_Type type; const char* name; } backends[] = {
+        {QUBIT_BACKEND_CLASSICAL, "classical"},
+        {QUBIT_BACKEND_PACKED, "packed"},
+#ifndef MOOP_FIXED_BACKEND
+        {QUBIT_BACKEND_BITSLICED, "bitsliced"},
+#endif
+    };
+
+    const uint32_t lengths[] = {256, L1_TAPE_SIZE, MAX_PROGRAM_LEN};
+
+    printf("Program execution (%u gates per run, Mgates/s)\n", TOTAL_GATES);
+    printf("%-10s %6s %12s %12s %8s\n", "backend", "length", "switch", "threaded", "speedup");
+
+    uint32_t checksum = 0;
+    for (size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); i++) {
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            double before = run(backends[i].type, lengths[l], false, &checksum);
+            double after = run(backends[i].type, lengths[l], true, &checksum);
+            printf("%-10s %6u %12.1f %12.1f %7.2fx\n", backends[i].name, lengths[l],
+                   before, after, after / before);
+        }
+    }
+    printf("(checksum %08x)\n", checksum);
+
+    return 0;
+}
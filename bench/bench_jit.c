@@ -0,0 +1,75 @@
+// bench_jit.c
+// Replaying one short gate sequence many times on the packed backend:
+// qubit_* switch loop vs threaded program vs the native JIT (cache hit
+// per run, so each JIT sample also pays the content hash and compare).
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_enhanced.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdint.h>
+
+#define SEQUENCE_LEN 300
+#define RUNS 20000
+#define QUBITS 256
+
+static R_Cell sequence[SEQUENCE_LEN];
+
+static void switch_loop(Qubit_State* s, const R_Cell* cells, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        R_Cell c = cells[i];
+        switch (c.gate) {
+            case 0: qubit_CCNOT(s, c.a, c.b, c.c); break;
+            case 1: qubit_CNOT(s, c.a, c.b); break;
+            case 2: qubit_NOT(s, c.a); break;
+            case 3: qubit_SWAP(s, c.a, c.b); break;
+        }
+    }
+}
+
+// ns per gate; mode 0 = switch, 1 = threaded, 2 = JIT
+static double run(int mode, uint32_t* checksum) {
+    L2a_Runtime* r = l2a_init(QUBITS, 0, QUBIT_BACKEND_PACKED);
+    L2a_Program* p = l2a_program_compile(sequence, SEQUENCE_LEN, QUBIT_BACKEND_PACKED);
+    l2a_set_jit(r, 4);
+
+    double start = bench_now();
+    for (uint32_t i = 0; i < RUNS; i++) {
+        if (mode == 0) switch_loop(r->qubit_state, sequence, SEQUENCE_LEN);
+        else if (mode == 1) l2a_program_run(p, r->qubit_state);
+        else l2a_jit_run(r, sequence, SEQUENCE_LEN);
+    }
+    double elapsed = bench_now() - start;
+
+    for (uint32_t q = 0; q < QUBITS; q++) {
+        *checksum = *checksum * 31 + qubit_read(r->qubit_state, (uint8_t)q);
+    }
+    l2a_program_free(p);
+    l2a_free(r);
+    return elapsed / ((double)RUNS * SEQUENCE_LEN) * 1e9;
+}
+
+int main(void) {
+    uint32_t seed = 0xB5297A4Du;
+    for (int i = 0; i < SEQUENCE_LEN; i++) {
+        sequence[i].gate = bench_rand(&seed) % 4;
+        sequence[i].a = bench_rand(&seed) % QUBITS;
+        sequence[i].b = bench_rand(&seed) % QUBITS;
+        sequence[i].c = bench_rand(&seed) % QUBITS;
+    }
+
+    uint32_t checksum = 0;
+    double interp = run(0, &checksum);
+    double threaded = run(1, &checksum);
+    double jit = run(2, &checksum);
+
+    printf("Packed backend, %d-gate sequence x %d runs (ns/gate)\n", SEQUENCE_LEN, RUNS);
+    printf("%-10s %8.2f\n", "switch", interp);
+    printf("%-10s %8.2f %7.2fx\n", "threaded", threaded, interp / threaded);
+    printf("%-10s %8.2f %7.2fx\n", "jit", jit, interp / jit);
+    printf("(checksum %08x)\n", checksum);
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+// bench_l2b.c
+// L2b boolean ops: the reversible expansion (l2a_* gates, one tape record
+// each: AND 1-2, XOR 2-3, OR 7-8, NOR 8-9) vs direct mode (one overwrite,
+// one dissipative record), with fast recording on. Ops that keep flipping
+// bits (NAND, NOR) also pay for activity refreshes at each prune.
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_enhanced.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdint.h>
+
+#define QUBITS 64
+#define OPS 2000000
+
+typedef void (*L2b_Fn)(L2b_Runtime*, uint8_t, uint8_t, uint8_t);
+
+// Average time per op in seconds
+static double measure(Qubit_Backend_Type backend, L2b_Fn fn, bool direct, uint32_t* checksum) {
+    L2a_Runtime* l2a = l2a_init(QUBITS, 0, backend);
+    L2b_Runtime* l2b = l2b_init(l2a);
+    l2a_set_fast_record(l2a, true);
+    l2b_set_direct(l2b, direct);
+
+    uint32_t seed = 0x1B0u;
+    for (uint8_t q = 0; q < QUBITS; q++) {
+        if (bench_rand(&seed) & 1) qubit_NOT(l2a->qubit_state, q);
+    }
+
+    double start = bench_now();
+    for (uint32_t i = 0; i < OPS; i++) {
+        uint32_t v = bench_rand(&seed);
+        uint8_t a = v % QUBITS, b = (v >> 8) % QUBITS, result = (v >> 16) % QUBITS;
+        if (result == a || result == b) result = (uint8_t)((a ^ b ^ 1) % QUBITS);
+        fn(l2b, a, b, result);
+    }
+    double elapsed = bench_now() - start;
+
+    for (uint8_t q = 0; q < QUBITS; q++) *checksum = *checksum * 31 + qubit_read(l2a->qubit_state, q);
+    l2b_free(l2b);
+    l2a_free(l2a);
+    return elapsed / OPS;
+}
+
+int main(void) {
+    const struct { Qubit_Backend_Type type; const char* name; } backends[] = {
+        {QUBIT_BACKEND_CLASSICAL, "classical"},
+        {QUBIT_BACKEND_PACKED, "packed"},
+    };
+    const struct { L2b_Fn fn; const char* name; } ops[] = {
+        {l2b_AND, "AND"}, {l2b_OR, "OR"}, {l2b_XOR, "XOR"}, {l2b_NOR, "NOR"},
+    };
+
+    printf("L2b ops, %d qubits, ns/op\n", QUBITS);
+    printf("%-10s %-4s %12s %12s %8s\n", "backend", "op", "reversible", "direct", "speedup");
+
+    uint32_t checksum = 0;
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++) {
+        for (size_t o = 0; o < sizeof(ops) / sizeof(ops[0]); o++) {
+            double rev = measure(backends[b].type, ops[o].fn, false, &checksum);
+            double dir = measure(backends[b].type, ops[o].fn, true, &checksum);
+            printf("%-10s %-4s %12.1f %12.1f %7.2fx\n", backends[b].name, ops[o].name,
+                   rev * 1e9, dir * 1e9, rev / dir);
+        }
+    }
+    printf("(checksum %08x)\n", checksum);
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+// bench_measure.c
+// Statevector simulator measurement: one qubit at a time vs
+// quantum_simulator_measure_qubits over the same qubits, per layout.
+// Needs -DENABLE_QUANTUM_SIMULATOR.
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_quantum_ready.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef ENABLE_QUANTUM_SIMULATOR
+
+#define REPS 4
+#define GROUP 8
+
+// Average time per measurement of GROUP qubits in seconds
+static double measure(uint32_t qubits, Sim_Layout layout, bool joint) {
+    Qubit_State* state = qubit_init(qubits, QUBIT_BACKEND_SIMULATOR);
+    quantum_simulator_set_layout(state, layout);
+
+    // Low, middle and high qubits
+    uint8_t group[GROUP], outcomes[GROUP];
+    for (uint32_t j = 0; j < GROUP; j++) group[j] = (uint8_t)(j * (qubits - 1) / (GROUP - 1));
+
+    double start = bench_now();
+    for (uint32_t r = 0; r < REPS; r++) {
+        if (joint) {
+            quantum_simulator_measure_qubits(state, group, GROUP, outcomes);
+        } else {
+            for (uint32_t j = 0; j < GROUP; j++) outcomes[j] = qubit_measure(state, group[j]);
+        }
+    }
+    double elapsed = bench_now() - start;
+
+    qubit_free(state);
+    return elapsed / REPS;
+}
+
+int main(void) {
+    const uint32_t sizes[] = {18, 20, 22, 24};
+    const struct { Sim_Layout layout; const char* name; } layouts[] = {
+        {SIM_LAYOUT_SPLIT, "split"},
+        {SIM_LAYOUT_INTERLEAVED, "interleaved"},
+    };
+
+    printf("Measuring %d qubits, ms per group\n", GROUP);
+    printf("%-8s %-12s %12s %12s %8s\n", "qubits", "layout", "one by one", "joint", "speedup");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++) {
+            double single = measure(sizes[s], layouts[l].layout, false);
+            double joint = measure(sizes[s], layouts[l].layout, true);
+            printf("%-8u %-12s %12.2f %12.2f %7.1fx\n", sizes[s], layouts[l].name, single * 1e3,
+                   joint * 1e3, single / joint);
+        }
+    }
+    return 0;
+}
+
+#else
+
+int main(void) {
+    printf("bench_measure: build with -DENABLE_QUANTUM_SIMULATOR\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,86 @@
+// bench_prune_latency.c
+// Per-op latency distribution of L2a gates with evolutionary pruning on.
+// Pruning runs every 64 ops (~1.5% of ops), so its cost lands at p99.
+// Runs once with full recording and once with l2a_set_fast_record.
+// Each run uses a fresh runtime for its first 1000 ops, before the tape
+// wraps and low-fitness records start being skipped.
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_enhanced.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define RUNS 200
+#define OPS_PER_RUN 1000
+#define OPS (RUNS * OPS_PER_RUN)
+#define QUBITS 16
+#define PRUNE_INTERVAL 64
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void run_mode(bool fast_record, double* latency) {
+    uint32_t seed = 12345;
+    uint32_t cycles = 0;
+    uint64_t reads_avoided = 0;
+    double prune_total = 0.0;
+
+    for (uint32_t run = 0; run < RUNS; run++) {
+        L2a_Runtime* r = l2a_init(QUBITS, run, QUBIT_BACKEND_CLASSICAL);
+        Fitness_Params params = l2a_get_fitness_params(r);
+        params.prune_interval = PRUNE_INTERVAL;
+        l2a_tune_fitness(r, params);
+        l2a_set_fast_record(r, fast_record);
+
+        for (uint32_t i = 0; i < OPS_PER_RUN; i++) {
+            uint8_t a = bench_rand(&seed) % QUBITS;
+            uint8_t b = bench_rand(&seed) % QUBITS;
+            uint8_t c = bench_rand(&seed) % QUBITS;
+            uint32_t gate = bench_rand(&seed) % 4;
+
+            double start = bench_now();
+            switch (gate) {
+                case 0: l2a_CCNOT(r, a, b, c); break;
+                case 1: l2a_CNOT(r, a, b); break;
+                case 2: l2a_NOT(r, a); break;
+                case 3: l2a_SWAP(r, a, b); break;
+            }
+            latency[run * OPS_PER_RUN + i] = bench_now() - start;
+        }
+        cycles += r->pruning_cycles;
+        reads_avoided += l2a_get_tape_stats(r).reads_avoided;
+
+        double prune_start = bench_now();
+        l2a_prune_tape(r);
+        prune_total += bench_now() - prune_start;
+
+        l2a_free(r);
+    }
+
+    qsort(latency, OPS, sizeof(double), compare_double);
+
+    printf("L2a per-op latency, %s recording, %d ops, prune every %d ops (%u prunes)\n",
+           fast_record ? "fast" : "full", OPS, PRUNE_INTERVAL, cycles);
+    printf("  p50   %8.0f ns\n", latency[OPS / 2] * 1e9);
+    printf("  p99   %8.0f ns\n", latency[OPS * 99 / 100] * 1e9);
+    printf("  p99.9 %8.0f ns\n", latency[OPS * 999 / 1000] * 1e9);
+    printf("  max   %8.0f ns\n", latency[OPS - 1] * 1e9);
+    printf("  l2a_prune_tape avg %8.1f us\n", prune_total / RUNS * 1e6);
+    printf("  qubit reads avoided %llu\n", (unsigned long long)reads_avoided);
+}
+
+int main(void) {
+    double* latency = malloc(OPS * sizeof(double));
+    if (!latency) return 1;
+
+    run_mode(false, latency);
+    run_mode(true, latency);
+
+    free(latency);
+    return 0;
+}
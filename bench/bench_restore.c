@@ -0,0 +1,118 @@
+// bench_restore.c
+// l2a_restore latency vs rewind distance, gate-by-gate vs snapshot restore.
+// Each sample runs OPS gates on a fresh runtime, then restores to
+// OPS - distance (not a checkpoint, so snapshots only help via replay).
+// Build with -DENABLE_QUANTUM_SIMULATOR to measure the statevector
+// backend, where every replayed gate is a full sweep.
+// The classical build also times the evaluation loop checkpoint, CYCLE_OPS
+// gates, restore, with and without copy-on-write checkpoints.
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_enhanced.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdint.h>
+
+#define OPS 1000
+#define REPS 20
+#define QUBITS 12
+#define SNAPSHOT_INTERVAL 64
+#define SNAPSHOT_COUNT 16
+#define CYCLES 100000
+#define CYCLE_OPS 16
+
+#ifdef ENABLE_QUANTUM_SIMULATOR
+#define BENCH_BACKEND QUBIT_BACKEND_SIMULATOR
+#else
+#define BENCH_BACKEND QUBIT_BACKEND_CLASSICAL
+#endif
+
+// Average restore time in seconds; *run_time gets the average gate-path time
+static double measure(uint32_t distance, bool snapshots, double* run_time) {
+    double restore_total = 0.0, run_total = 0.0;
+
+    for (uint32_t rep = 0; rep < REPS; rep++) {
+        L2a_Runtime* r = l2a_init(QUBITS, rep, BENCH_BACKEND);
+        Fitness_Params params = l2a_get_fitness_params(r);
+        params.prune_interval = UINT32_MAX;  // Keep the replayed history intact
+        l2a_tune_fitness(r, params);
+        if (snapshots) l2a_set_snapshots(r, SNAPSHOT_INTERVAL, SNAPSHOT_COUNT);
+
+        uint32_t seed = 777 + rep;
+        double start = bench_now();
+        for (uint32_t i = 0; i < OPS; i++) {
+            uint8_t a = bench_rand(&seed) % QUBITS;
+            uint8_t b = (a + 1 + bench_rand(&seed) % (QUBITS - 1)) % QUBITS;
+            if (i % 2) l2a_CNOT(r, a, b);
+            else l2a_NOT(r, a);
+        }
+        run_total += bench_now() - start;
+
+        start = bench_now();
+        l2a_restore(r, OPS - distance);
+        restore_total += bench_now() - start;
+
+        l2a_free(r);
+    }
+
+    *run_time = run_total / REPS;
+    return restore_total / REPS;
+}
+
+#ifndef ENABLE_QUANTUM_SIMULATOR
+// Average checkpoint + CYCLE_OPS gates + restore cycle time in seconds
+static double measure_cycle(bool cow) {
+    L2a_Runtime* r = l2a_init(QUBITS, 0, BENCH_BACKEND);
+    Fitness_Params params = l2a_get_fitness_params(r);
+    params.prune_interval = UINT32_MAX;
+    l2a_tune_fitness(r, params);
+    if (cow) l2a_set_cow_checkpoints(r, true);
+
+    uint32_t seed = 99;
+    double start = bench_now();
+    for (uint32_t c = 0; c < CYCLES; c++) {
+        uint32_t cp = l2a_checkpoint(r);
+        for (uint32_t i = 0; i < CYCLE_OPS; i++) {
+            uint8_t a = bench_rand(&seed) % QUBITS;
+            uint8_t b = (a + 1 + bench_rand(&seed) % (QUBITS - 1)) % QUBITS;
+            if (i % 2) l2a_CNOT(r, a, b);
+            else l2a_NOT(r, a);
+        }
+        l2a_restore(r, cp);
+    }
+    double elapsed = bench_now() - start;
+
+    l2a_free(r);
+    return elapsed / CYCLES;
+}
+#endif
+
+int main(void) {
+    const uint32_t distances[] = {8, 64, 250, 500, 1000};
+
+    printf("l2a_restore latency, %s backend, %d qubits, %d ops before restore\n",
+           BENCH_BACKEND == QUBIT_BACKEND_CLASSICAL ? "classical" : "simulator", QUBITS, OPS);
+    printf("snapshots: every %d ops, ring of %d\n", SNAPSHOT_INTERVAL, SNAPSHOT_COUNT);
+    printf("%-10s %14s %14s %8s\n", "distance", "rewind (us)", "snapshot (us)", "speedup");
+
+    double run_plain = 0.0, run_snap = 0.0;
+    for (size_t i = 0; i < sizeof(distances) / sizeof(distances[0]); i++) {
+        double plain = measure(distances[i], false, &run_plain);
+        double snap = measure(distances[i], true, &run_snap);
+        printf("%-10u %14.2f %14.2f %7.1fx\n", distances[i],
+               plain * 1e6, snap * 1e6, plain / snap);
+    }
+    printf("gate path for %d ops: %.1f us plain, %.1f us with snapshots\n",
+           OPS, run_plain * 1e6, run_snap * 1e6);
+
+#ifndef ENABLE_QUANTUM_SIMULATOR
+    double rewind = measure_cycle(false);
+    double cow = measure_cycle(true);
+    printf("checkpoint + %d ops + restore: %.1f ns rewind, %.1f ns copy-on-write (%.1fx)\n",
+           CYCLE_OPS, rewind * 1e9, cow * 1e9, rewind / cow);
+#endif
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+// bench_sim_gates.c
+// Statevector simulator gate kernels, one sweep per gate (fusion off),
+// per gate type, register size and amplitude layout (split re/im arrays
+// vs interleaved pairs).
+// Needs -DENABLE_QUANTUM_SIMULATOR.
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_quantum_ready.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef ENABLE_QUANTUM_SIMULATOR
+
+#define GATES 48
+
+// Average time per gate in seconds. Operands cycle through low, middle
+// and high qubits so every stride is exercised
+static double measure(uint32_t qubits, Sim_Layout layout, uint32_t kind) {
+    Qubit_State* state = qubit_init(qubits, QUBIT_BACKEND_SIMULATOR);
+    quantum_simulator_set_fusion(state, false);
+    quantum_simulator_set_layout(state, layout);
+
+    uint32_t seed = 0x5EEDu + kind;
+    double start = bench_now();
+    for (uint32_t i = 0; i < GATES; i++) {
+        uint8_t a = bench_rand(&seed) % qubits;
+        uint8_t b = (a + 1 + bench_rand(&seed) % (qubits - 1)) % qubits;
+        uint8_t c = (b + 1) % qubits == a ? (b + 2) % qubits : (b + 1) % qubits;
+        switch (kind) {
+            case 0: qubit_CCNOT(state, a, b, c); break;
+            case 1: qubit_CNOT(state, a, b); break;
+            case 2: qubit_NOT(state, a); break;
+            case 3: qubit_SWAP(state, a, b); break;
+        }
+    }
+    double elapsed = bench_now() - start;
+
+    qubit_free(state);
+    return elapsed / GATES;
+}
+
+int main(void) {
+    const char* names[4] = {"CCNOT", "CNOT", "NOT", "SWAP"};
+    const uint32_t sizes[] = {16, 20, 24};
+
+    printf("Statevector gate kernels (fusion off), us/gate\n");
+    printf("%-8s %-12s", "qubits", "layout");
+    for (uint32_t k = 0; k < 4; k++) printf(" %10s", names[k]);
+    printf("\n");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        double split[4];
+        printf("%-8u %-12s", sizes[s], "split");
+        for (uint32_t k = 0; k < 4; k++) {
+            split[k] = measure(sizes[s], SIM_LAYOUT_SPLIT, k);
+            printf(" %10.1f", split[k] * 1e6);
+        }
+        double interleaved[4];
+        printf("\n%-8u %-12s", sizes[s], "interleaved");
+        for (uint32_t k = 0; k < 4; k++) {
+            interleaved[k] = measure(sizes[s], SIM_LAYOUT_INTERLEAVED, k);
+            printf(" %10.1f", interleaved[k] * 1e6);
+        }
+        printf("\n%-8s %-12s", "", "speedup");
+        for (uint32_t k = 0; k < 4; k++) printf(" %9.2fx", split[k] / interleaved[k]);
+        printf("\n");
+    }
+    return 0;
+}
+
+#else
+
+int main(void) {
+    printf("bench_sim_gates: build with -DENABLE_QUANTUM_SIMULATOR\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,111 @@
+// bench_sim_read.c
+// Statevector simulator reads: the fitness pattern (one CNOT, then read
+// its three operands) through qubit_measure vs the cached, non-collapsing
+// qubit_read; and shots of 8 qubits from a superposition, by measuring a
+// copy per shot vs quantum_simulator_sample.
+// Needs -DENABLE_QUANTUM_SIMULATOR.
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_quantum_ready.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#ifdef ENABLE_QUANTUM_SIMULATOR
+
+#define OPS 64
+#define GROUP 8
+#define SHOTS 1024
+#define COPY_SHOTS 8
+
+// Average time per CNOT + three reads in seconds
+static double fitness_reads(uint32_t qubits, bool measure, uint32_t* checksum) {
+    Qubit_State* state = qubit_init(qubits, QUBIT_BACKEND_SIMULATOR);
+    uint32_t seed = 0xF17u;
+    for (uint8_t q = 0; q < qubits; q += 2) qubit_NOT(state, q);
+
+    double start = bench_now();
+    for (uint32_t i = 0; i < OPS; i++) {
+        uint8_t a = bench_rand(&seed) % qubits;
+        uint8_t b = (a + 1 + bench_rand(&seed) % (qubits - 1)) % qubits;
+        uint8_t c = (b + 1) % qubits == a ? (b + 2) % qubits : (b + 1) % qubits;
+        qubit_CNOT(state, a, b);
+        const uint8_t read[3] = {a, b, c};
+        for (uint32_t k = 0; k < 3; k++) {
+            uint8_t v = measure ? qubit_measure(state, read[k]) : qubit_read(state, read[k]);
+            *checksum = *checksum * 31 + v;
+        }
+    }
+    double elapsed = bench_now() - start;
+
+    qubit_free(state);
+    return elapsed / OPS;
+}
+
+// Average time per shot of GROUP qubits in seconds
+static double shots(uint32_t qubits, bool sample, uint32_t* checksum) {
+    Qubit_State* state = qubit_init(qubits, QUBIT_BACKEND_SIMULATOR);
+    Quantum_Simulator_State* q = state->backend_data;
+    double a = 1.0 / sqrt((double)q->state_size);
+    for (uint64_t i = 0; i < q->state_size; i++) quantum_simulator_set_amplitude(state, i, a, 0.0);
+
+    uint8_t group[GROUP], outcomes[GROUP];
+    for (uint32_t j = 0; j < GROUP; j++) group[j] = (uint8_t)(j * (qubits - 1) / (GROUP - 1));
+
+    static uint64_t results[SHOTS];
+    uint32_t count = sample ? SHOTS : COPY_SHOTS;
+    Qubit_State* scratch = qubit_clone(state);
+    double start = bench_now();
+    if (sample) {
+        quantum_simulator_sample(state, group, GROUP, SHOTS, results);
+        for (uint32_t s = 0; s < SHOTS; s++) *checksum = *checksum * 31 + (uint32_t)results[s];
+    } else {
+        for (uint32_t s = 0; s < COPY_SHOTS; s++) {
+            qubit_copy(scratch, state);
+            quantum_simulator_measure_qubits(scratch, group, GROUP, outcomes);
+            for (uint32_t j = 0; j < GROUP; j++) *checksum = *checksum * 31 + outcomes[j];
+        }
+    }
+    double elapsed = bench_now() - start;
+
+    qubit_free(scratch);
+    qubit_free(state);
+    return elapsed / count;
+}
+
+int main(void) {
+    const uint32_t sizes[] = {16, 20, 22};
+    uint32_t checksum = 0;
+
+    printf("CNOT + 3 reads (basis state), us per op\n");
+    printf("%-8s %12s %12s %8s\n", "qubits", "measure", "read", "speedup");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        double measured = fitness_reads(sizes[s], true, &checksum);
+        double read = fitness_reads(sizes[s], false, &checksum);
+        printf("%-8u %12.1f %12.1f %7.1fx\n", sizes[s], measured * 1e6, read * 1e6,
+               measured / read);
+    }
+
+    printf("\n%d-qubit shots from a uniform superposition, us per shot\n", GROUP);
+    printf("%-8s %12s %12s %8s\n", "qubits", "copy+measure", "sample", "speedup");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        double copied = shots(sizes[s], false, &checksum);
+        double sampled = shots(sizes[s], true, &checksum);
+        printf("%-8u %12.1f %12.1f %7.1fx\n", sizes[s], copied * 1e6, sampled * 1e6,
+               copied / sampled);
+    }
+    printf("(checksum %08x)\n", checksum);
+    return 0;
+}
+
+#else
+
+int main(void) {
+    printf("bench_sim_read: build with -DENABLE_QUANTUM_SIMULATOR\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,84 @@
+// bench_sim_sparse.c
+// Permutation gates on the dense statevector simulator (fusion on) vs the
+// sparse backend at 20 qubits, for states of 1 to 4096 terms; then the
+// sparse backend alone on 64-qubit registers the dense one cannot hold.
+// Needs -DENABLE_QUANTUM_SIMULATOR.
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_quantum_ready.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef ENABLE_QUANTUM_SIMULATOR
+
+#define GATES 4096
+
+// Average time per gate in seconds, starting from terms equal amplitudes
+static double run_gates(Qubit_Backend_Type backend, uint32_t qubits, uint32_t terms,
+                        uint32_t* checksum) {
+    Qubit_State* state = qubit_init(qubits, backend);
+    uint32_t seed = 0x5BA25Eu;
+    bool sparse = backend == QUBIT_BACKEND_SPARSE;
+    if (sparse) sparse_simulator_set_amplitude(state, 0, 0.0, 0.0);
+    else quantum_simulator_set_amplitude(state, 0, 0.0, 0.0);
+    for (uint32_t t = 0; t < terms; t++) {
+        // Distinct indices: t spread over the register by a fixed odd multiplier
+        uint64_t index = ((uint64_t)t * 0x9E3779B97F4A7C15ULL) >> (64 - qubits);
+        if (sparse) sparse_simulator_set_amplitude(state, index, 1.0, 0.0);
+        else quantum_simulator_set_amplitude(state, index, 1.0, 0.0);
+    }
+
+    double start = bench_now();
+    for (uint32_t g = 0; g < GATES; g++) {
+        uint8_t a = bench_rand(&seed) % qubits;
+        uint8_t b = (a + 1 + bench_rand(&seed) % (qubits - 1)) % qubits;
+        uint8_t c = (b + 1) % qubits == a ? (b + 2) % qubits : (b + 1) % qubits;
+        switch (bench_rand(&seed) % 4) {
+            case 0: qubit_CCNOT(state, a, b, c); break;
+            case 1: qubit_CNOT(state, a, b); break;
+            case 2: qubit_NOT(state, a); break;
+            case 3: qubit_SWAP(state, a, b); break;
+        }
+    }
+    if (!sparse) quantum_simulator_flush(state);
+    double elapsed = bench_now() - start;
+
+    *checksum = *checksum * 31 + qubit_read(state, 0);
+    qubit_free(state);
+    return elapsed / GATES;
+}
+
+int main(void) {
+    const uint32_t terms[] = {1, 64, 4096};
+    uint32_t checksum = 0;
+
+    printf("20 qubits, %d random gates, ns/gate\n", GATES);
+    printf("%-8s %12s %12s %8s\n", "terms", "dense", "sparse", "speedup");
+    for (size_t t = 0; t < sizeof(terms) / sizeof(terms[0]); t++) {
+        double dense = run_gates(QUBIT_BACKEND_SIMULATOR, 20, terms[t], &checksum);
+        double sparse = run_gates(QUBIT_BACKEND_SPARSE, 20, terms[t], &checksum);
+        printf("%-8u %12.1f %12.1f %7.0fx\n", terms[t], dense * 1e9, sparse * 1e9, dense / sparse);
+    }
+
+    const uint32_t wide[] = {1, 64, 4096, 65536};
+    printf("\nSparse only, 64 qubits, ns/gate\n");
+    printf("%-8s %12s %12s\n", "terms", "ns/gate", "ns/term");
+    for (size_t t = 0; t < sizeof(wide) / sizeof(wide[0]); t++) {
+        double sparse = run_gates(QUBIT_BACKEND_SPARSE, 64, wide[t], &checksum);
+        printf("%-8u %12.1f %12.2f\n", wide[t], sparse * 1e9, sparse * 1e9 / wide[t]);
+    }
+    printf("(checksum %08x)\n", checksum);
+    return 0;
+}
+
+#else
+
+int main(void) {
+    printf("bench_sim_sparse: build with -DENABLE_QUANTUM_SIMULATOR\n");
+    return 0;
+}
+
+#endif
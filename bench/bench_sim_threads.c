@@ -0,0 +1,81 @@
+// bench_sim_threads.c
+// Statevector simulator thread scaling: gate sweeps (fusion off) and
+// measure + renormalize, from 1 thread up to the online CPU count.
+// Registers run from 18 qubits to MAX (default 24; pass e.g. 28 as the
+// first argument on a machine with the memory for 2^28 amplitudes).
+// Needs -DENABLE_QUANTUM_SIMULATOR.
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_quantum_ready.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#ifdef ENABLE_QUANTUM_SIMULATOR
+
+#define GATES 16
+#define MEASURES 4
+
+// Average time per gate sweep and per measurement in seconds
+static void measure(uint32_t qubits, uint32_t threads, double* gate_time, double* measure_time) {
+    Qubit_State* state = qubit_init(qubits, QUBIT_BACKEND_SIMULATOR);
+    quantum_simulator_set_fusion(state, false);
+    quantum_simulator_set_threads(state, threads);
+
+    uint32_t seed = 0x7EADu;
+    double start = bench_now();
+    for (uint32_t i = 0; i < GATES; i++) {
+        uint8_t a = bench_rand(&seed) % qubits;
+        uint8_t b = (a + 1 + bench_rand(&seed) % (qubits - 1)) % qubits;
+        uint8_t c = (b + 1) % qubits == a ? (b + 2) % qubits : (b + 1) % qubits;
+        if (i % 2) qubit_CCNOT(state, a, b, c);
+        else qubit_NOT(state, a);
+    }
+    *gate_time = (bench_now() - start) / GATES;
+
+    start = bench_now();
+    for (uint32_t i = 0; i < MEASURES; i++) qubit_measure(state, (uint8_t)(i * 5 % qubits));
+    *measure_time = (bench_now() - start) / MEASURES;
+
+    qubit_free(state);
+}
+
+int main(int argc, char** argv) {
+    uint32_t max_qubits = argc > 1 ? (uint32_t)atoi(argv[1]) : 24;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t max_threads = cpus < 1 ? 1 : (cpus > SIM_MAX_THREADS ? SIM_MAX_THREADS : (uint32_t)cpus);
+
+    printf("Statevector thread scaling, %u online CPUs, ms per sweep (speedup vs 1 thread)\n",
+           (unsigned)cpus);
+    printf("%-7s %-8s", "qubits", "threads");
+    printf(" %20s %20s\n", "gate", "measure");
+    for (uint32_t qubits = 18; qubits <= max_qubits; qubits += 2) {
+        double gate_1 = 0.0, measure_1 = 0.0;
+        for (uint32_t threads = 1;; threads *= 2) {
+            if (threads > max_threads) threads = max_threads;
+            double gate, meas;
+            measure(qubits, threads, &gate, &meas);
+            if (threads == 1) {
+                gate_1 = gate;
+                measure_1 = meas;
+            }
+            printf("%-7u %-8u %12.2f (%4.1fx) %12.2f (%4.1fx)\n", qubits, threads, gate * 1e3,
+                   gate_1 / gate, meas * 1e3, measure_1 / meas);
+            if (threads == max_threads) break;
+        }
+    }
+    return 0;
+}
+
+#else
+
+int main(void) {
+    printf("bench_sim_threads: build with -DENABLE_QUANTUM_SIMULATOR\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,63 @@
+// bench_tape_simd.c
+// Tape statistics and batch fitness throughput for every kernel variant
+// this CPU supports (scalar, SSE2, AVX2 / NEON)
+//
+// Run: make bench
+
+#define _POSIX_C_SOURCE 200809L
+#include "../src/moop_enhanced.h"
+#include "../src/tape_simd.h"
+#include "bench_util.h"
+#include <stdio.h>
+
+#define CALLS 100000
+
+int main(void) {
+    L2a_Runtime* r = l2a_init(16, 0, QUBIT_BACKEND_CLASSICAL);
+    uint32_t seed = 7;
+    for (uint32_t i = 0; i < 1000; i++) {
+        l2a_CNOT(r, bench_rand(&seed) % 16, bench_rand(&seed) % 16);
+    }
+    for (uint32_t i = 0; i < L1_TAPE_SIZE; i += 50) l2a_mark_essential(r, i);
+
+    const Tape_Kernels* variants[4];
+    uint32_t count = tape_kernels_supported(variants, 4);
+
+    printf("Tape kernels over %d entries (ns/call, selected: %s)\n",
+           L1_TAPE_SIZE, tape_kernels()->name);
+    printf("%-8s %10s %10s %10s\n", "kernel", "stats", "fitness", "speedup");
+
+    double base_stats = 0.0, base_fitness = 0.0;
+    float sink = 0.0f;
+    for (uint32_t v = 0; v < count; v++) {
+        const Tape_Kernels* k = variants[v];
+
+        // Everything l2a_get_tape_stats does
+        double start = bench_now();
+        for (int i = 0; i < CALLS; i++) {
+            float min = 1.0f, max = 0.0f, sum;
+            k->fitness_stats(r->tape.fitness, L1_TAPE_SIZE, &min, &max, &sum);
+            sink += sum + min + max +
+                    k->active_count(r->tape.cells, L1_TAPE_SIZE) +
+                    k->essential_count(r->tape.essential, L1_TAPE_SIZE / 64);
+        }
+        double stats = (bench_now() - start) / CALLS * 1e9;
+
+        start = bench_now();
+        for (int i = 0; i < CALLS; i++) {
+            k->batch_fitness(&r->tape, L1_TAPE_SIZE, r->total_ops + i, &r->fitness_params);
+        }
+        double fitness = (bench_now() - start) / CALLS * 1e9;
+
+        if (v == 0) {
+            base_stats = stats;
+            base_fitness = fitness;
+        }
+        printf("%-8s %10.0f %10.0f %5.1fx/%.1fx\n", k->name, stats, fitness,
+               base_stats / stats, base_fitness / fitness);
+    }
+    printf("(sink %g)\n", sink);
+
+    l2a_free(r);
+    return 0;
+}
@@ -0,0 +1,24 @@
+// bench_util.h
+// Shared timing helpers for the Moop microbenchmarks
+
+#ifndef MOOP_BENCH_UTIL_H
+#define MOOP_BENCH_UTIL_H
+
+#include <stdint.h>
+#include <time.h>
+
+static inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Small deterministic PRNG so runs are comparable across machines
+static inline uint32_t bench_rand(uint32_t* seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    return *seed;
+}
+
+#endif // MOOP_BENCH_UTIL_H
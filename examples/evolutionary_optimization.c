@@ -27,51 +27,65 @@ typedef struct {
     float fitness;
 } GateSequence;
 
-// Compute XOR using a gate sequence (test fitness)
-static float evaluate_sequence(L2a_Runtime* runtime, GateSequence* seq, uint8_t a_val, uint8_t b_val) {
-    // Create checkpoint before testing
-    uint32_t checkpoint = l2a_checkpoint(runtime);
-
-    // Set initial qubit values
-    if (a_val) l2a_NOT(runtime, 0);  // Set qubit 0 = a
-    if (b_val) l2a_NOT(runtime, 1);  // Set qubit 1 = b
-
-    // Execute the gate sequence
+static void run_sequence(Qubit_State* state, GateSequence* seq) {
     for (uint32_t i = 0; i < seq->length; i++) {
         R_Cell cell = seq->sequence[i];
         switch (cell.gate) {
-            case 0: l2a_CCNOT(runtime, cell.a, cell.b, cell.c); break;
-            case 1: l2a_CNOT(runtime, cell.a, cell.b); break;
-            case 2: l2a_NOT(runtime, cell.a); break;
-            case 3: l2a_SWAP(runtime, cell.a, cell.b); break;
+            case 0: qubit_CCNOT(state, cell.a, cell.b, cell.c); break;
+            case 1: qubit_CNOT(state, cell.a, cell.b); break;
+            case 2: qubit_NOT(state, cell.a); break;
+            case 3: qubit_SWAP(state, cell.a, cell.b); break;
         }
     }
+}
+
+#ifndef MOOP_FIXED_BACKEND
+#define EVAL_BACKEND QUBIT_BACKEND_BITSLICED
 
-    // Check result on qubit 2 (should be a XOR b)
-    uint8_t result = qubit_read(runtime->qubit_state, 2);
-    uint8_t expected = a_val ^ b_val;
+// Test sequence against all inputs in one bit-sliced pass
+// Lane k of the bit-sliced state holds truth-table row k (a = bit 1, b = bit 0)
+static float test_all_cases(Qubit_State* lanes, GateSequence* seq) {
+    // XOR truth table: 00->0, 01->1, 10->1, 11->0
+    const uint64_t rows = 0xF;
+    const uint64_t expected = 0x6;
+
+    uint64_t a[BITSLICE_WORDS] = {0xC};
+    uint64_t b[BITSLICE_WORDS] = {0xA};
+    uint64_t zero[BITSLICE_WORDS] = {0};
+    qubit_bitsliced_load(lanes, 0, a);
+    qubit_bitsliced_load(lanes, 1, b);
+    qubit_bitsliced_load(lanes, 2, zero);
 
-    // Fitness: 1.0 if correct, 0.0 if wrong
-    float fitness = (result == expected) ? 1.0f : 0.0f;
+    // Execute the gate sequence once for every row
+    run_sequence(lanes, seq);
 
-    // Restore to checkpoint (reversibility!)
-    l2a_restore(runtime, checkpoint);
+    // Check result on qubit 2 (should be a XOR b) in every row
+    uint64_t result[BITSLICE_WORDS];
+    qubit_bitsliced_store(lanes, 2, result);
+    uint64_t correct = ~(result[0] ^ expected) & rows;
 
-    return fitness;
+    return __builtin_popcountll(correct) / 4.0f;  // Average fitness
 }
+#else
+#define EVAL_BACKEND QUBIT_BACKEND_CLASSICAL
 
-// Test sequence against all inputs
-static float test_all_cases(L2a_Runtime* runtime, GateSequence* seq) {
-    float total = 0.0f;
+// Fixed-backend builds have no bit-sliced lanes: evaluate row by row
+static float test_all_cases(Qubit_State* state, GateSequence* seq) {
+    uint32_t correct = 0;
 
-    // XOR truth table: 00->0, 01->1, 10->1, 11->0
-    total += evaluate_sequence(runtime, seq, 0, 0);  // Should be 0
-    total += evaluate_sequence(runtime, seq, 0, 1);  // Should be 1
-    total += evaluate_sequence(runtime, seq, 1, 0);  // Should be 1
-    total += evaluate_sequence(runtime, seq, 1, 1);  // Should be 0
+    for (uint8_t row = 0; row < 4; row++) {
+        uint8_t inputs[3] = {(row >> 1) & 1, row & 1, 0};
+        for (uint8_t q = 0; q < 3; q++) {
+            if (qubit_read(state, q) != inputs[q]) qubit_NOT(state, q);
+        }
 
-    return total / 4.0f;  // Average fitness
+        run_sequence(state, seq);
+        if (qubit_read(state, 2) == (inputs[0] ^ inputs[1])) correct++;
+    }
+
+    return correct / 4.0f;  // Average fitness
 }
+#endif
 
 // Generate random gate sequence
 static GateSequence random_sequence(uint32_t max_length) {
@@ -156,6 +170,10 @@ int main(void) {
     printf("Backend: %s\n", qubit_backend_name(runtime->qubit_state));
     printf("Is quantum: %s\n\n", qubit_is_quantum(runtime->qubit_state) ? "Yes" : "No");
 
+    // Fitness evaluation runs every truth-table row at once on bit-sliced lanes
+    // (row by row in fixed-backend builds)
+    Qubit_State* lanes = qubit_init(3, EVAL_BACKEND);
+
     // Evolutionary parameters
     const uint32_t population_size = 20;
     const uint32_t generations = 50;
@@ -165,15 +183,19 @@ int main(void) {
     GateSequence population[population_size];
     for (uint32_t i = 0; i < population_size; i++) {
         population[i] = random_sequence(max_sequence_length);
-        population[i].fitness = test_all_cases(runtime, &population[i]);
+        population[i].fitness = test_all_cases(lanes, &population[i]);
     }
 
     printf("Initial population: %u sequences\n", population_size);
     printf("Max sequence length: %u gates\n", max_sequence_length);
     printf("Generations: %u\n\n", generations);
 
-    // Evolution loop
+    // Evolution loop (best owns its own copy of the sequence)
     GateSequence best = population[0];
+    best.sequence = malloc(best.length * sizeof(R_Cell));
+    for (uint32_t j = 0; j < best.length; j++) {
+        best.sequence[j] = population[0].sequence[j];
+    }
 
     for (uint32_t gen = 0; gen < generations; gen++) {
         // Find best in population
@@ -198,19 +220,11 @@ int main(void) {
                 print_sequence(&best);
                 printf("\nVerifying solution:\n");
 
-                // Actually execute and read results
+                // Actually execute and read results (one batch per row)
                 uint32_t verify_checkpoint = l2a_checkpoint(runtime);
 
                 // Test 0 XOR 0 = 0
-                for (uint32_t i = 0; i < best.length; i++) {
-                    R_Cell c = best.sequence[i];
-                    switch (c.gate) {
-                        case 0: l2a_CCNOT(runtime, c.a, c.b, c.c); break;
-                        case 1: l2a_CNOT(runtime, c.a, c.b); break;
-                        case 2: l2a_NOT(runtime, c.a); break;
-                        case 3: l2a_SWAP(runtime, c.a, c.b); break;
-                    }
-                }
+                l2a_execute_batch(runtime, best.sequence, best.length);
                 printf("  XOR(0,0) = %u (expected 0) %s\n",
                        qubit_read(runtime->qubit_state, 2),
                        qubit_read(runtime->qubit_state, 2) == 0 ? "✓" : "✗");
@@ -218,15 +232,7 @@ int main(void) {
 
                 // Test 0 XOR 1 = 1
                 l2a_NOT(runtime, 1);  // Set b=1
-                for (uint32_t i = 0; i < best.length; i++) {
-                    R_Cell c = best.sequence[i];
-                    switch (c.gate) {
-                        case 0: l2a_CCNOT(runtime, c.a, c.b, c.c); break;
-                        case 1: l2a_CNOT(runtime, c.a, c.b); break;
-                        case 2: l2a_NOT(runtime, c.a); break;
-                        case 3: l2a_SWAP(runtime, c.a, c.b); break;
-                    }
-                }
+                l2a_execute_batch(runtime, best.sequence, best.length);
                 printf("  XOR(0,1) = %u (expected 1) %s\n",
                        qubit_read(runtime->qubit_state, 2),
                        qubit_read(runtime->qubit_state, 2) == 1 ? "✓" : "✗");
@@ -234,15 +240,7 @@ int main(void) {
 
                 // Test 1 XOR 0 = 1
                 l2a_NOT(runtime, 0);  // Set a=1
-                for (uint32_t i = 0; i < best.length; i++) {
-                    R_Cell c = best.sequence[i];
-                    switch (c.gate) {
-                        case 0: l2a_CCNOT(runtime, c.a, c.b, c.c); break;
-                        case 1: l2a_CNOT(runtime, c.a, c.b); break;
-                        case 2: l2a_NOT(runtime, c.a); break;
-                        case 3: l2a_SWAP(runtime, c.a, c.b); break;
-                    }
-                }
+                l2a_execute_batch(runtime, best.sequence, best.length);
                 printf("  XOR(1,0) = %u (expected 1) %s\n",
                        qubit_read(runtime->qubit_state, 2),
                        qubit_read(runtime->qubit_state, 2) == 1 ? "✓" : "✗");
@@ -251,15 +249,7 @@ int main(void) {
                 // Test 1 XOR 1 = 0
                 l2a_NOT(runtime, 0);  // Set a=1
                 l2a_NOT(runtime, 1);  // Set b=1
-                for (uint32_t i = 0; i < best.length; i++) {
-                    R_Cell c = best.sequence[i];
-                    switch (c.gate) {
-                        case 0: l2a_CCNOT(runtime, c.a, c.b, c.c); break;
-                        case 1: l2a_CNOT(runtime, c.a, c.b); break;
-                        case 2: l2a_NOT(runtime, c.a); break;
-                        case 3: l2a_SWAP(runtime, c.a, c.b); break;
-                    }
-                }
+                l2a_execute_batch(runtime, best.sequence, best.length);
                 printf("  XOR(1,1) = %u (expected 0) %s\n",
                        qubit_read(runtime->qubit_state, 2),
                        qubit_read(runtime->qubit_state, 2) == 0 ? "✓" : "✗");
@@ -274,7 +264,7 @@ int main(void) {
 
             // Mutate best sequence
             population[i] = mutate_sequence(&best);
-            population[i].fitness = test_all_cases(runtime, &population[i]);
+            population[i].fitness = test_all_cases(lanes, &population[i]);
         }
 
         // Replace worst with new random (diversity)
@@ -282,7 +272,7 @@ int main(void) {
             free(population[population_size - 1].sequence);
             population[population_size - 1] = random_sequence(max_sequence_length);
             population[population_size - 1].fitness =
-                test_all_cases(runtime, &population[population_size - 1]);
+                test_all_cases(lanes, &population[population_size - 1]);
         }
     }
 
@@ -291,7 +281,12 @@ int main(void) {
     printf("╚═══════════════════════════════════════════════════════════╝\n\n");
 
     printf("✓ Homoiconicity: Code (gate sequences) treated as data\n");
-    printf("✓ Reversibility: Each test uses checkpoint/restore\n");
+    printf("✓ Reversibility: Verification uses checkpoint/restore\n");
+#ifndef MOOP_FIXED_BACKEND
+    printf("✓ Bit-Slicing: All truth-table rows evaluated in one pass\n");
+#else
+    printf("✓ Fixed Backend: Truth-table rows evaluated one at a time\n");
+#endif
     printf("✓ Evolution: Population evolves toward optimal solution\n");
     printf("✓ Self-Organization: System finds solution autonomously\n");
     printf("✓ Quantum-Ready: Same code works on classical/quantum backends\n\n");
@@ -306,6 +301,7 @@ int main(void) {
         free(population[i].sequence);
     }
     free(best.sequence);
+    qubit_free(lanes);
     l2a_free(runtime);
 
     printf("This demonstrates what NO other language can do:\n");
@@ -58,7 +58,7 @@ int main(void) {
         R_Cell cell = l2a_read_tape(runtime, i);
         printf("  tape[%u]: ", i);
         print_gate(cell);
-        printf(" (fitness=%.2f)\n", runtime->tape[i].fitness);
+        printf(" (fitness=%.2f)\n", runtime->tape.fitness[i]);
     }
     printf("\n");
 
@@ -0,0 +1,205 @@
+// bitsliced_backend.c
+// Bit-sliced classical backend: BITSLICE_LANES independent instances
+// Bit k of every qubit slice belongs to lane k, so each gate is a handful
+// of word-wide AND/XOR ops that evaluate all lanes simultaneously
+
+#define _POSIX_C_SOURCE 200809L
+#include "moop_quantum_ready.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Slice Helpers
+// ============================================================================
+
+#define SLICE_BYTES (BITSLICE_WORDS * sizeof(uint64_t))
+
+static inline uint64_t* slice_of(const Qubit_State* state, uint8_t qubit) {
+    return ((Bitsliced_Qubit_State*)state->backend_data)->slices +
+           (size_t)qubit * BITSLICE_WORDS;
+}
+
+// ============================================================================
+// Bit-Sliced Backend Implementation
+// ============================================================================
+
+static Qubit_State* bitsliced_init(uint32_t n_qubits) {
+    Qubit_State* state = malloc(sizeof(Qubit_State));
+    if (!state) return NULL;
+
+    state->backend_type = QUBIT_BACKEND_BITSLICED;
+    state->ops = &bitsliced_backend_ops;
+    state->qubit_count = n_qubits;
+    state->metadata = NULL;
+
+    Bitsliced_Qubit_State* sliced = malloc(sizeof(Bitsliced_Qubit_State));
+    if (!sliced) {
+        free(state);
+        return NULL;
+    }
+
+    // 32-byte alignment lets 256-lane slices live in single AVX2 registers
+    size_t bytes = (size_t)(n_qubits ? n_qubits : 1) * SLICE_BYTES;
+    bytes = (bytes + 31) & ~(size_t)31;
+    sliced->slices = aligned_alloc(32, bytes);
+    if (!sliced->slices) {
+        free(sliced);
+        free(state);
+        return NULL;
+    }
+    memset(sliced->slices, 0, bytes);
+
+    state->backend_data = sliced;
+    return state;
+}
+
+static void bitsliced_free(Qubit_State* state) {
+    if (!state) return;
+
+    Bitsliced_Qubit_State* sliced = (Bitsliced_Qubit_State*)state->backend_data;
+
+    if (sliced) {
+        free(sliced->slices);
+        free(sliced);
+    }
+
+    free(state);
+}
+
+static void bitsliced_copy(Qubit_State* dst, const Qubit_State* src) {
+    memcpy(((Bitsliced_Qubit_State*)dst->backend_data)->slices,
+           ((const Bitsliced_Qubit_State*)src->backend_data)->slices,
+           (size_t)src->qubit_count * SLICE_BYTES);
+}
+
+static Qubit_State* bitsliced_clone(const Qubit_State* state) {
+    if (!state) return NULL;
+
+    Qubit_State* cloned = bitsliced_init(state->qubit_count);
+    if (!cloned) return NULL;
+
+    bitsliced_copy(cloned, state);
+
+    return cloned;
+}
+
+// ============================================================================
+// Lane-Parallel Reversible Gates
+// ============================================================================
+
+static void bitsliced_CCNOT(Qubit_State* state, uint8_t a, uint8_t b, uint8_t c) {
+    uint64_t* sa = slice_of(state, a);
+    uint64_t* sb = slice_of(state, b);
+    uint64_t* sc = slice_of(state, c);
+
+    // Toffoli in every lane: c ^= a & b
+    for (uint32_t w = 0; w < BITSLICE_WORDS; w++) {
+        sc[w] ^= sa[w] & sb[w];
+    }
+}
+
+static void bitsliced_CNOT(Qubit_State* state, uint8_t a, uint8_t b) {
+    uint64_t* sa = slice_of(state, a);
+    uint64_t* sb = slice_of(state, b);
+
+    for (uint32_t w = 0; w < BITSLICE_WORDS; w++) {
+        sb[w] ^= sa[w];
+    }
+}
+
+static void bitsliced_NOT(Qubit_State* state, uint8_t a) {
+    uint64_t* sa = slice_of(state, a);
+
+    for (uint32_t w = 0; w < BITSLICE_WORDS; w++) {
+        sa[w] = ~sa[w];
+    }
+}
+
+static void bitsliced_SWAP(Qubit_State* state, uint8_t a, uint8_t b) {
+    uint64_t* sa = slice_of(state, a);
+    uint64_t* sb = slice_of(state, b);
+
+    for (uint32_t w = 0; w < BITSLICE_WORDS; w++) {
+        uint64_t temp = sa[w];
+        sa[w] = sb[w];
+        sb[w] = temp;
+    }
+}
+
+// ============================================================================
+// Lane Access
+// ============================================================================
+
+void qubit_bitsliced_set_lane(Qubit_State* state, uint32_t lane, uint8_t qubit, uint8_t value) {
+    if (!state || state->backend_type != QUBIT_BACKEND_BITSLICED) return;
+    if (lane >= BITSLICE_LANES) return;
+
+    uint64_t* slice = slice_of(state, qubit);
+    uint64_t bit = 1ULL << (lane & 63);
+    slice[lane >> 6] = value ? (slice[lane >> 6] | bit) : (slice[lane >> 6] & ~bit);
+}
+
+uint8_t qubit_bitsliced_get_lane(const Qubit_State* state, uint32_t lane, uint8_t qubit) {
+    if (!state || state->backend_type != QUBIT_BACKEND_BITSLICED) return 0;
+    if (lane >= BITSLICE_LANES) return 0;
+
+    return (uint8_t)((slice_of(state, qubit)[lane >> 6] >> (lane & 63)) & 1);
+}
+
+void qubit_bitsliced_load(Qubit_State* state, uint8_t qubit, const uint64_t* lanes) {
+    if (!state || state->backend_type != QUBIT_BACKEND_BITSLICED) return;
+    memcpy(slice_of(state, qubit), lanes, SLICE_BYTES);
+}
+
+void qubit_bitsliced_store(const Qubit_State* state, uint8_t qubit, uint64_t* lanes) {
+    if (!state || state->backend_type != QUBIT_BACKEND_BITSLICED) return;
+    memcpy(lanes, slice_of(state, qubit), SLICE_BYTES);
+}
+
+// ============================================================================
+// Measurement (Lane 0)
+// ============================================================================
+
+static uint8_t bitsliced_measure(Qubit_State* state, uint8_t qubit) {
+    return (uint8_t)(slice_of(state, qubit)[0] & 1);
+}
+
+static uint8_t bitsliced_read(const Qubit_State* state, uint8_t qubit) {
+    return (uint8_t)(slice_of(state, qubit)[0] & 1);
+}
+
+static double bitsliced_probability(const Qubit_State* state, uint8_t qubit) {
+    return (double)(slice_of(state, qubit)[0] & 1);
+}
+
+// ============================================================================
+// Backend Info
+// ============================================================================
+
+static const char* bitsliced_name(void) {
+    return "Classical (Bit-Sliced Multi-Instance)";
+}
+
+static bool bitsliced_is_quantum(void) {
+    return false;
+}
+
+// ============================================================================
+// Operations Table
+// ============================================================================
+
+const Qubit_Backend_Ops bitsliced_backend_ops = {
+    .init = bitsliced_init,
+    .free = bitsliced_free,
+    .clone = bitsliced_clone,
+    .copy = bitsliced_copy,
+    .CCNOT = bitsliced_CCNOT,
+    .CNOT = bitsliced_CNOT,
+    .NOT = bitsliced_NOT,
+    .SWAP = bitsliced_SWAP,
+    .measure = bitsliced_measure,
+    .read = bitsliced_read,
+    .probability = bitsliced_probability,
+    .name = bitsliced_name,
+    .is_quantum = bitsliced_is_quantum
+};
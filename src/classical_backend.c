@@ -16,6 +16,7 @@ static Qubit_State* classical_init(uint32_t n_qubits) {
     if (!state) return NULL;
 
     state->backend_type = QUBIT_BACKEND_CLASSICAL;
+    state->ops = &classical_backend_ops;
     state->qubit_count = n_qubits;
     state->metadata = NULL;
 
@@ -50,18 +51,18 @@ static void classical_free(Qubit_State* state) {
     free(state);
 }
 
+static void classical_copy(Qubit_State* dst, const Qubit_State* src) {
+    memcpy(QUBIT_CLASSICAL_BITS(dst), QUBIT_CLASSICAL_BITS(src),
+           src->qubit_count * sizeof(uint8_t));
+}
+
 static Qubit_State* classical_clone(const Qubit_State* state) {
     if (!state) return NULL;
 
     Qubit_State* cloned = classical_init(state->qubit_count);
     if (!cloned) return NULL;
 
-    Classical_Qubit_State* src =
-        (Classical_Qubit_State*)state->backend_data;
-    Classical_Qubit_State* dst =
-        (Classical_Qubit_State*)cloned->backend_data;
-
-    memcpy(dst->bits, src->bits, state->qubit_count * sizeof(uint8_t));
+    classical_copy(cloned, state);
 
     return cloned;
 }
@@ -70,42 +71,26 @@ static Qubit_State* classical_clone(const Qubit_State* state) {
 // Classical Reversible Gates
 // ============================================================================
 
-static void classical_CCNOT(Qubit_State* state, uint8_t a, uint8_t b, uint8_t c) {
-    Classical_Qubit_State* classical =
-        (Classical_Qubit_State*)state->backend_data;
+// Kernels live in moop_quantum_ready.h so qubit_* can inline them
 
+static void classical_CCNOT(Qubit_State* state, uint8_t a, uint8_t b, uint8_t c) {
     // Toffoli gate: if (a AND b) then flip c
-    if (classical->bits[a] && classical->bits[b]) {
-        classical->bits[c] ^= 1;
-    }
+    classical_bits_CCNOT(QUBIT_CLASSICAL_BITS(state), a, b, c);
 }
 
 static void classical_CNOT(Qubit_State* state, uint8_t a, uint8_t b) {
-    Classical_Qubit_State* classical =
-        (Classical_Qubit_State*)state->backend_data;
-
     // Controlled-NOT: if a then flip b
-    if (classical->bits[a]) {
-        classical->bits[b] ^= 1;
-    }
+    classical_bits_CNOT(QUBIT_CLASSICAL_BITS(state), a, b);
 }
 
 static void classical_NOT(Qubit_State* state, uint8_t a) {
-    Classical_Qubit_State* classical =
-        (Classical_Qubit_State*)state->backend_data;
-
     // NOT gate: flip bit
-    classical->bits[a] ^= 1;
+    classical_bits_NOT(QUBIT_CLASSICAL_BITS(state), a);
 }
 
 static void classical_SWAP(Qubit_State* state, uint8_t a, uint8_t b) {
-    Classical_Qubit_State* classical =
-        (Classical_Qubit_State*)state->backend_data;
-
     // SWAP: exchange bits
-    uint8_t temp = classical->bits[a];
-    classical->bits[a] = classical->bits[b];
-    classical->bits[b] = temp;
+    classical_bits_SWAP(QUBIT_CLASSICAL_BITS(state), a, b);
 }
 
 // ============================================================================
@@ -128,6 +113,14 @@ static uint8_t classical_read(const Qubit_State* state, uint8_t qubit) {
     return classical->bits[qubit];
 }
 
+static double classical_probability(const Qubit_State* state, uint8_t qubit) {
+    // A classical bit is 1 with certainty or not at all
+    const Classical_Qubit_State* classical =
+        (const Classical_Qubit_State*)state->backend_data;
+
+    return classical->bits[qubit];
+}
+
 // ============================================================================
 // Backend Info
 // ============================================================================
@@ -148,12 +141,14 @@ const Qubit_Backend_Ops classical_backend_ops = {
     .init = classical_init,
     .free = classical_free,
     .clone = classical_clone,
+    .copy = classical_copy,
     .CCNOT = classical_CCNOT,
     .CNOT = classical_CNOT,
     .NOT = classical_NOT,
     .SWAP = classical_SWAP,
     .measure = classical_measure,
     .read = classical_read,
+    .probability = classical_probability,
     .name = classical_name,
     .is_quantum = classical_is_quantum
 };
@@ -0,0 +1,345 @@
+// gate_jit.c
+// Native code cache for L2a gate sequences
+// On x86-64 a packed-backend sequence becomes one straight-line function:
+// the state words it touches live in r8-r11 for the whole run, so each
+// gate is a few register ALU ops with no dispatch and no memory traffic
+
+#define _DEFAULT_SOURCE  // MAP_ANONYMOUS
+#include "gate_jit.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+// ============================================================================
+// x86-64 Code Generation
+// ============================================================================
+
+#ifdef GATE_JIT_X86_64
+
+enum { RAX = 0, RDX = 2, R8 = 8 };
+
+// Qubit q's word is held in register r8 + (q >> 6)
+#define WORD_REG(q) (uint8_t)(R8 + ((q) >> 6))
+#define BIT(q) (uint8_t)((q) & 63)
+
+// Worst case per gate (a dissipative op) is 12 instructions, 42 bytes
+#define MAX_GATE_BYTES 44
+
+// op rm, reg (64-bit register form: mov 89, or 09, and 21, xor 31)
+static uint8_t* emit_rr(uint8_t* p, uint8_t op, uint8_t rm, uint8_t reg) {
+    *p++ = 0x48 | ((reg >> 3) << 2) | (rm >> 3);
+    *p++ = op;
+    *p++ = 0xC0 | ((reg & 7) << 3) | (rm & 7);
+    return p;
+}
+
+// Group op rm, imm8 (shl C1/4, shr C1/5, and 83/4, xor 83/6)
+static uint8_t* emit_ri(uint8_t* p, uint8_t op, uint8_t ext, uint8_t rm, uint8_t imm) {
+    *p++ = 0x48 | (rm >> 3);
+    *p++ = op;
+    *p++ = 0xC0 | (ext << 3) | (rm & 7);
+    *p++ = imm;
+    return p;
+}
+
+static uint8_t* emit_shift(uint8_t* p, uint8_t ext, uint8_t rm, uint8_t amount) {
+    return amount ? emit_ri(p, 0xC1, ext, rm, amount) : p;
+}
+
+// mov reg, [rdi + 8 * word]  /  mov [rdi + 8 * word], reg
+static uint8_t* emit_mem(uint8_t* p, uint8_t op, uint8_t reg, uint32_t word) {
+    *p++ = 0x48 | ((reg >> 3) << 2);
+    *p++ = op;
+    *p++ = 0x40 | ((reg & 7) << 3) | 7;
+    *p++ = (uint8_t)(word * 8);
+    return p;
+}
+
+// scratch = bit q, in bit 0 (upper bits garbage until masked)
+static uint8_t* emit_extract(uint8_t* p, uint8_t scratch, uint8_t q) {
+    p = emit_rr(p, 0x89, scratch, WORD_REG(q));
+    return emit_shift(p, 5, scratch, BIT(q));
+}
+
+// word(q) ^= rax << bit(q), rax holding 0 or 1
+static uint8_t* emit_flip(uint8_t* p, uint8_t scratch, uint8_t q) {
+    p = emit_shift(p, 4, scratch, BIT(q));
+    return emit_rr(p, 0x31, WORD_REG(q), scratch);
+}
+
+static uint8_t* emit_gate(uint8_t* p, R_Cell c) {
+    switch (c.gate) {
+        case 0:  // CCNOT: c ^= a & b
+            p = emit_extract(p, RAX, c.a);
+            p = emit_extract(p, RDX, c.b);
+            p = emit_rr(p, 0x21, RAX, RDX);
+            p = emit_ri(p, 0x83, 4, RAX, 1);
+            return emit_flip(p, RAX, c.c);
+        case 1:  // CNOT: b ^= a
+            p = emit_extract(p, RAX, c.a);
+            p = emit_ri(p, 0x83, 4, RAX, 1);
+            return emit_flip(p, RAX, c.b);
+        case 2:  // NOT: btc word(a), bit(a)
+            *p++ = 0x48 | (WORD_REG(c.a) >> 3);
+            *p++ = 0x0F;
+            *p++ = 0xBA;
+            *p++ = 0xC0 | (7 << 3) | (WORD_REG(c.a) & 7);
+            *p++ = BIT(c.a);
+            return p;
+        case 3:  // SWAP: flip both bits iff they differ
+            p = emit_extract(p, RAX, c.a);
+            p = emit_extract(p, RDX, c.b);
+            p = emit_rr(p, 0x31, RAX, RDX);
+            p = emit_ri(p, 0x83, 4, RAX, 1);
+            p = emit_rr(p, 0x89, RDX, RAX);
+            p = emit_flip(p, RAX, c.a);
+            return emit_flip(p, RDX, c.b);
+    }
+
+    // Dissipative: rax = op(a, b), then flip c iff it differs
+    static const uint8_t combine[] = {0x21, 0x09, 0x31, 0x21, 0x09};
+    uint8_t op = (c.gate & 0x0F) >> 1;
+    p = emit_extract(p, RAX, c.a);
+    p = emit_extract(p, RDX, c.b);
+    p = emit_rr(p, combine[op], RAX, RDX);
+    if (op == L2B_OP_NAND || op == L2B_OP_NOR) p = emit_ri(p, 0x83, 6, RAX, 1);
+    p = emit_extract(p, RDX, c.c);
+    p = emit_rr(p, 0x31, RAX, RDX);
+    p = emit_ri(p, 0x83, 4, RAX, 1);
+    return emit_flip(p, RAX, c.c);
+}
+
+// Straight-line void fn(uint64_t* words) into *fn, left NULL if the host
+// refuses the mapping (the threaded program runs instead). False if an
+// operand lies past the state's words
+static bool compile_native(const R_Cell* cells, uint32_t n, const uint64_t written[4],
+                           uint32_t word_count, Gate_Jit_Fn* fn, size_t* size_out) {
+    *fn = NULL;
+
+    // Words read or written anywhere in the sequence
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        R_Cell c = cells[i];
+        bool dissipative = l2a_is_dissipative(c.gate);
+        if (c.gate > 3 && !dissipative) continue;
+        uint32_t words = 1u << (c.a >> 6);
+        if (c.gate != 2) words |= 1u << (c.b >> 6);
+        if (c.gate == 0 || dissipative) words |= 1u << (c.c >> 6);
+        used |= words;
+    }
+    if (word_count < 4 && (used >> word_count)) return false;
+
+    size_t size = (size_t)n * MAX_GATE_BYTES + 4 * 2 * 4 + 1;
+    size_t page = 4096;
+    size = (size + page - 1) & ~(page - 1);
+    uint8_t* code = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED) return true;
+
+    uint8_t* p = code;
+    for (uint32_t w = 0; w < 4; w++) {
+        if (used & (1u << w)) p = emit_mem(p, 0x8B, R8 + w, w);
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        if (cells[i].gate <= 3 || l2a_is_dissipative(cells[i].gate)) p = emit_gate(p, cells[i]);
+    }
+    for (uint32_t w = 0; w < 4; w++) {
+        if (written[w]) p = emit_mem(p, 0x89, R8 + w, w);
+    }
+    *p++ = 0xC3;  // ret
+
+    // W^X: never writable and executable at once
+    if (mprotect(code, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(code, size);
+        return true;
+    }
+
+    *size_out = size;
+    *fn = (Gate_Jit_Fn)(void*)code;
+    return true;
+}
+
+#endif // GATE_JIT_X86_64
+
+// ============================================================================
+// Cache
+// ============================================================================
+
+// Multiply-xorshift over two cells at a time (a byte-wise hash would cost
+// more than running the compiled code)
+static uint64_t hash_cells(const R_Cell* cells, uint32_t n) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ n;
+    uint32_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        uint64_t v;
+        memcpy(&v, &cells[i], sizeof(v));
+        h = ((h ^ v) * 0xFF51AFD7ED558CCDULL);
+        h ^= h >> 32;
+    }
+    if (i < n) {
+        uint32_t v;
+        memcpy(&v, &cells[i], sizeof(v));
+        h = ((h ^ v) * 0xFF51AFD7ED558CCDULL);
+        h ^= h >> 32;
+    }
+    return h;
+}
+
+static void entry_clear(Gate_Jit_Entry* e) {
+    if (e->native) munmap((void*)e->native, e->native_size);
+    l2a_program_free(e->program);
+    free(e->cells);
+    memset(e, 0, sizeof(*e));
+}
+
+void gate_jit_free(L2a_Jit* jit) {
+    if (!jit) return;
+    for (uint32_t i = 0; i < jit->capacity; i++) entry_clear(&jit->entries[i]);
+    free(jit->entries);
+    free(jit);
+}
+
+void gate_jit_invalidate(L2a_Jit* jit, uint32_t slot, uint32_t tape_mask) {
+    for (uint32_t i = 0; i < jit->capacity; i++) {
+        Gate_Jit_Entry* e = &jit->entries[i];
+        if (e->valid && e->span != GATE_JIT_NO_SPAN &&
+            ((slot - e->span) & tape_mask) < e->length) {
+            entry_clear(e);
+        }
+    }
+}
+
+bool l2a_set_jit(L2a_Runtime* r, uint32_t capacity) {
+    gate_jit_free(r->jit);
+    r->jit = NULL;
+    if (capacity == 0) return true;
+
+    L2a_Jit* jit = calloc(1, sizeof(L2a_Jit));
+    if (!jit) return false;
+    jit->entries = calloc(capacity, sizeof(Gate_Jit_Entry));
+    if (!jit->entries) {
+        free(jit);
+        return false;
+    }
+    jit->capacity = capacity;
+    r->jit = jit;
+    return true;
+}
+
+static Gate_Jit_Entry* compile_entry(L2a_Runtime* r, const R_Cell* cells, uint32_t n,
+                                     uint64_t hash, uint32_t span) {
+    L2a_Jit* jit = r->jit;
+    Gate_Jit_Entry* e = &jit->entries[jit->next];
+    entry_clear(e);
+
+    // Keyed by the cells as given, compiled from their optimized form
+    uint32_t code_length = n;
+    const R_Cell* code = l2a_optimize_cells(r, cells, &code_length);
+
+    e->cells = malloc(((size_t)n + 1) * sizeof(R_Cell));
+    e->program = l2a_program_compile(code, code_length, r->qubit_state->backend_type);
+    if (!e->cells || !e->program) {
+        entry_clear(e);
+        return NULL;
+    }
+    memcpy(e->cells, cells, (size_t)n * sizeof(R_Cell));
+    memcpy(e->written, e->program->written, sizeof(e->written));
+    e->hash = hash;
+    e->length = n;
+    e->span = span;
+
+#ifdef GATE_JIT_X86_64
+    Qubit_State* s = r->qubit_state;
+    if (s->backend_type == QUBIT_BACKEND_PACKED) {
+        uint32_t word_count = ((Packed_Qubit_State*)s->backend_data)->word_count;
+        if (!compile_native(code, code_length, e->written, word_count,
+                            &e->native, &e->native_size)) {
+            entry_clear(e);  // The interpreter would index past the state too
+            return NULL;
+        }
+        if (e->native) {
+            l2a_program_free(e->program);
+            e->program = NULL;
+        }
+    }
+#endif
+
+    e->valid = true;
+    jit->last = jit->next;
+    jit->next = (jit->next + 1) % jit->capacity;
+    jit->compiles++;
+    return e;
+}
+
+static bool run_entry(L2a_Runtime* r, const Gate_Jit_Entry* e) {
+    l2a_touch_written(r, e->written);
+    if (e->native) {
+        e->native(QUBIT_PACKED_WORDS(r->qubit_state));
+        return true;
+    }
+    return l2a_program_run(e->program, r->qubit_state);
+}
+
+bool l2a_jit_run(L2a_Runtime* r, const R_Cell* cells, uint32_t n) {
+    L2a_Jit* jit = r->jit;
+    if (!jit) return false;
+    if (n == 0) return true;  // Nothing to run (cells may be NULL)
+    size_t bytes = (size_t)n * sizeof(R_Cell);
+
+    // Replaying the same sequence back to back skips the hash
+    const Gate_Jit_Entry* last = &jit->entries[jit->last];
+    if (last->valid && last->length == n && last->span == GATE_JIT_NO_SPAN &&
+        memcmp(last->cells, cells, bytes) == 0) {
+        return run_entry(r, last);
+    }
+
+    uint64_t hash = hash_cells(cells, n);
+    for (uint32_t i = 0; i < jit->capacity; i++) {
+        const Gate_Jit_Entry* e = &jit->entries[i];
+        if (e->valid && e->hash == hash && e->length == n && e->span == GATE_JIT_NO_SPAN &&
+            memcmp(e->cells, cells, bytes) == 0) {
+            jit->last = i;
+            return run_entry(r, e);
+        }
+    }
+
+    const Gate_Jit_Entry* e = compile_entry(r, cells, n, hash, GATE_JIT_NO_SPAN);
+    return e && run_entry(r, e);
+}
+
+bool l2a_jit_run_tape(L2a_Runtime* r, uint32_t from, uint32_t to) {
+    if (!r->jit) return false;
+
+    // Same clamping as l2a_program_from_tape
+    if (to > r->total_ops) to = r->total_ops;
+    uint32_t oldest = (r->total_ops > r->tape.size) ? r->total_ops - r->tape.size : 0;
+    if (from < oldest) from = oldest;
+    uint32_t n = (from < to) ? to - from : 0;
+
+    // The range as at most two contiguous pieces of the ring
+    uint32_t span = from & r->tape.mask;
+    uint32_t first = (n < r->tape.size - span) ? n : r->tape.size - span;
+    const R_Cell* head = &r->tape.cells[span];
+    const R_Cell* tail = r->tape.cells;
+    size_t first_bytes = (size_t)first * sizeof(R_Cell);
+    size_t tail_bytes = (size_t)(n - first) * sizeof(R_Cell);
+
+    // Recording and pruning rewrite cells without invalidating, so a hit
+    // is confirmed against the live tape
+    for (uint32_t i = 0; i < r->jit->capacity; i++) {
+        const Gate_Jit_Entry* e = &r->jit->entries[i];
+        if (e->valid && e->span == span && e->length == n &&
+            memcmp(e->cells, head, first_bytes) == 0 &&
+            memcmp(e->cells + first, tail, tail_bytes) == 0) {
+            return run_entry(r, e);
+        }
+    }
+
+    R_Cell* cells = malloc(((size_t)n + 1) * sizeof(R_Cell));
+    if (!cells) return false;
+    memcpy(cells, head, first_bytes);
+    memcpy(cells + first, tail, tail_bytes);
+
+    const Gate_Jit_Entry* e = compile_entry(r, cells, n, hash_cells(cells, n), span);
+    free(cells);
+    return e && run_entry(r, e);
+}
@@ -0,0 +1,45 @@
+// gate_jit.h
+// Native code cache for L2a gate sequences (internal)
+// x86-64 (System V) emits straight-line code for the packed backend; every
+// other target and backend caches a threaded L2a_Program instead
+
+#ifndef GATE_JIT_H
+#define GATE_JIT_H
+
+#include "moop_enhanced.h"
+#include <stddef.h>
+
+#if defined(__x86_64__) && !defined(_WIN32)
+#define GATE_JIT_X86_64 1
+#endif
+
+#define GATE_JIT_NO_SPAN UINT32_MAX
+
+typedef void (*Gate_Jit_Fn)(uint64_t* words);
+
+typedef struct {
+    uint64_t hash;             // Multiply-xorshift over the cells (hash_cells)
+    R_Cell* cells;             // Source copy, compared on every hit
+    uint32_t length;
+    uint32_t span;             // First tape slot (GATE_JIT_NO_SPAN: caller's array)
+    uint64_t written[4];       // Qubits the sequence writes
+    Gate_Jit_Fn native;        // Executable mapping, or NULL
+    size_t native_size;
+    L2a_Program* program;      // Fallback when there is no native code
+    bool valid;
+} Gate_Jit_Entry;
+
+struct L2a_Jit {
+    Gate_Jit_Entry* entries;
+    uint32_t capacity;
+    uint32_t next;             // Ring slot the next compile overwrites
+    uint32_t last;             // Most recent hit, checked before hashing
+    uint32_t compiles;         // Cache misses so far
+};
+
+// Drop every entry compiled from a tape range covering slot
+void gate_jit_invalidate(L2a_Jit* jit, uint32_t slot, uint32_t tape_mask);
+
+void gate_jit_free(L2a_Jit* jit);
+
+#endif // GATE_JIT_H
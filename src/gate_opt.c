@@ -0,0 +1,216 @@
+// gate_opt.c
+// Peephole optimizer for reversible gate sequences
+// Every reversible primitive is its own inverse, so a gate cancels an
+// identical gate earlier in the sequence when everything in between
+// commutes with it. Runs of SWAPs collapse to the fewest transpositions
+// that produce the same permutation.
+
+#define _POSIX_C_SOURCE 200809L
+#include "moop_enhanced.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Longest SWAP run rewritten as one permutation
+#define SWAP_RUN 32
+
+// Sequences up to this length keep their undo log on the stack
+#define STACK_UNDO 256
+
+// Qubits a gate touches and the subset it writes
+typedef struct {
+    uint8_t touched[3];
+    uint8_t touch_count;
+    uint8_t written[2];
+    uint8_t write_count;
+} Gate_Operands;
+
+// What keeping a gate overwrote, so cancelling it later can roll back
+typedef struct {
+    uint32_t touch_prev[3];
+    uint32_t write_prev[2];
+    bool dead;
+} Gate_Undo;
+
+// Repeated operands (CCNOT a a c) are listed twice, which the rollback
+// tolerates: it restores a qubit only while it still names the partner
+static inline Gate_Operands gate_operands(R_Cell c) {
+    static const uint8_t touch_count[4] = {3, 2, 1, 2};
+    Gate_Operands o = {{c.a, c.b, c.c}, touch_count[c.gate], {c.a, c.b}, 1};
+    if (c.gate == 0) o.written[0] = c.c;
+    if (c.gate == 1) o.written[0] = c.b;
+    if (c.gate == 3) o.write_count = 2;
+    return o;
+}
+
+// Operands in canonical order (CCNOT controls and SWAP are symmetric),
+// unused operands zeroed
+static R_Cell canonical(R_Cell c) {
+    switch (c.gate) {
+        case 0: if (c.a > c.b) { uint8_t t = c.a; c.a = c.b; c.b = t; } break;
+        case 1: c.c = 0; break;
+        case 2: c.b = 0; c.c = 0; break;
+        case 3: if (c.a > c.b) { uint8_t t = c.a; c.a = c.b; c.b = t; } c.c = 0; break;
+    }
+    return c;
+}
+
+// Only bijective gates are self-inverse: CNOT a a clears a, and a CCNOT
+// targeting one of its controls is not reversible either
+static bool self_inverse(R_Cell c) {
+    switch (c.gate) {
+        case 0: return c.c != c.a && c.c != c.b;
+        case 1: return c.a != c.b;
+        case 2: return true;
+        case 3: return c.a != c.b;
+    }
+    return false;
+}
+
+static inline bool same_cell(R_Cell x, R_Cell y) {
+    return x.gate == y.gate && x.a == y.a && x.b == y.b && x.c == y.c;
+}
+
+// Replace cells[0..n) (all SWAPs) by the fewest SWAPs with the same
+// permutation; returns the new count
+static uint32_t merge_swaps(R_Cell* cells, uint32_t n) {
+    // pos[k] = original qubit whose value ends up at qubits[k]
+    uint8_t qubits[2 * SWAP_RUN], pos[2 * SWAP_RUN];
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        uint8_t ends[2] = {cells[i].a, cells[i].b};
+        uint32_t idx[2];
+        for (uint32_t e = 0; e < 2; e++) {
+            uint32_t j = 0;
+            while (j < k && qubits[j] != ends[e]) j++;
+            if (j == k) {
+                qubits[k] = ends[e];
+                pos[k++] = ends[e];
+            }
+            idx[e] = j;
+        }
+        uint8_t t = pos[idx[0]];
+        pos[idx[0]] = pos[idx[1]];
+        pos[idx[1]] = t;
+    }
+
+    // Selection: fix each position with one swap (n - cycles swaps total)
+    uint8_t cur[2 * SWAP_RUN];
+    memcpy(cur, qubits, k);
+    uint32_t out = 0;
+    for (uint32_t p = 0; p < k; p++) {
+        if (cur[p] == pos[p]) continue;
+        uint32_t j = p + 1;
+        while (cur[j] != pos[p]) j++;
+        cells[out++] = canonical((R_Cell){3, qubits[p], qubits[j], 0});
+        uint8_t t = cur[p];
+        cur[p] = cur[j];
+        cur[j] = t;
+    }
+    return out;
+}
+
+uint32_t l2a_optimize(R_Cell* cells, uint32_t n, L2a_Opt_Stats* stats) {
+    Gate_Undo stack_undo[STACK_UNDO];
+    Gate_Undo* undo = stack_undo;
+    if (n > STACK_UNDO) undo = malloc((size_t)n * sizeof(Gate_Undo));
+    if (!undo) {
+        if (stats) *stats = (L2a_Opt_Stats){n, n, 0, 0};
+        return n;  // Unoptimized is still correct
+    }
+
+    // Pass 1: cancel self-inverse pairs. Kept gates are appended in place
+    // and a cancelled partner is only marked dead, so positions stay put.
+    // Per qubit, the position + 1 of the last kept gate touching / writing
+    // it (0 = none): a gate's partner can only be the last gate touching
+    // what it writes, and nothing may have written its controls since
+    uint32_t last_touch[256], last_write[256];
+    memset(last_touch, 0, sizeof(last_touch));
+    memset(last_write, 0, sizeof(last_write));
+    uint32_t floor = 0;  // Position + 1 of the last barrier (gate > 3)
+    uint32_t out = 0, cancelled = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        R_Cell g = canonical(cells[i]);
+        if (g.gate == 3 && g.a == g.b) {  // SWAP a a
+            cancelled++;
+            continue;
+        }
+        if (g.gate > 3) {
+            undo[out].dead = false;
+            cells[out++] = g;
+            floor = out;
+            continue;
+        }
+
+        Gate_Operands o = gate_operands(g);
+        if (self_inverse(g)) {
+            uint32_t partner = 0;
+            for (uint8_t k = 0; k < o.write_count; k++) {
+                if (last_touch[o.written[k]] > partner) partner = last_touch[o.written[k]];
+            }
+
+            bool cancels = partner > floor && same_cell(cells[partner - 1], g);
+            for (uint8_t k = 0; cancels && k < o.touch_count; k++) {
+                cancels = last_write[o.touched[k]] <= partner;
+            }
+
+            if (cancels) {
+                Gate_Undo* u = &undo[partner - 1];
+                u->dead = true;
+                for (uint8_t k = 0; k < o.touch_count; k++) {
+                    if (last_touch[o.touched[k]] == partner) last_touch[o.touched[k]] = u->touch_prev[k];
+                }
+                for (uint8_t k = 0; k < o.write_count; k++) {
+                    last_write[o.written[k]] = u->write_prev[k];
+                }
+                cancelled += 2;
+                continue;
+            }
+        }
+
+        Gate_Undo* u = &undo[out];
+        u->dead = false;
+        cells[out++] = g;
+        for (uint8_t k = 0; k < o.touch_count; k++) {
+            u->touch_prev[k] = last_touch[o.touched[k]];
+            last_touch[o.touched[k]] = out;
+        }
+        for (uint8_t k = 0; k < o.write_count; k++) {
+            u->write_prev[k] = last_write[o.written[k]];
+            last_write[o.written[k]] = out;
+        }
+    }
+
+    // Pass 2: compact out the dead gates, rewriting each run of SWAPs
+    // (adjacent once the dead are gone) as a minimal permutation
+    uint32_t merged = 0, len = 0;
+    R_Cell run[SWAP_RUN];
+    for (uint32_t i = 0; i < out; i++) {
+        if (undo[i].dead) continue;
+        if (cells[i].gate != 3) {
+            cells[len++] = cells[i];
+            continue;
+        }
+
+        uint32_t count = 0;
+        for (; i < out && count < SWAP_RUN && (undo[i].dead || cells[i].gate == 3); i++) {
+            if (!undo[i].dead) run[count++] = cells[i];
+        }
+        i--;
+
+        uint32_t kept = (count > 1) ? merge_swaps(run, count) : count;
+        merged += count - kept;
+        memcpy(&cells[len], run, kept * sizeof(R_Cell));
+        len += kept;
+    }
+
+    if (undo != stack_undo) free(undo);
+
+    if (stats) {
+        stats->input_gates = n;
+        stats->output_gates = len;
+        stats->cancelled = cancelled;
+        stats->swaps_merged = merged;
+    }
+    return len;
+}
@@ -0,0 +1,275 @@
+// l2b_circuit.c
+// Compiled L2b boolean circuits
+// A circuit is built once as a DAG of irreversible ops, scheduled and
+// register-allocated onto ancilla qubits, and lowered to dissipative cells.
+// Each evaluation is then one threaded-program (or JIT) run over the state
+// instead of an l2b_* call per op.
+
+#define _POSIX_C_SOURCE 200809L
+#include "moop_enhanced.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define WIRE_NONE UINT32_MAX
+#define LIVE_TO_END UINT32_MAX
+
+L2b_Circuit* l2b_circuit_create(void) {
+    return calloc(1, sizeof(L2b_Circuit));
+}
+
+static void circuit_reset(L2b_Circuit* c) {
+    free(c->cells);
+    l2a_program_free(c->program);
+    c->cells = NULL;
+    c->cell_count = 0;
+    c->ancillas_used = 0;
+    c->program = NULL;
+}
+
+void l2b_circuit_free(L2b_Circuit* c) {
+    if (!c) return;
+    circuit_reset(c);
+    free(c->nodes);
+    free(c->outputs);
+    free(c);
+}
+
+static L2b_Wire add_node(L2b_Circuit* c, L2b_Node node) {
+    if (c->node_count == c->node_capacity) {
+        uint32_t capacity = c->node_capacity ? c->node_capacity * 2 : 64;
+        L2b_Node* grown = realloc(c->nodes, (size_t)capacity * sizeof(L2b_Node));
+        if (!grown) return WIRE_NONE;
+        c->nodes = grown;
+        c->node_capacity = capacity;
+    }
+    c->nodes[c->node_count] = node;
+    return c->node_count++;
+}
+
+L2b_Wire l2b_circuit_input(L2b_Circuit* c, uint8_t qubit) {
+    return add_node(c, (L2b_Node){L2B_NODE_INPUT, qubit, 0, 0});
+}
+
+L2b_Wire l2b_circuit_gate(L2b_Circuit* c, L2b_Op op, L2b_Wire x, L2b_Wire y) {
+    if (op > L2B_OP_NOR || x >= c->node_count || y >= c->node_count) return WIRE_NONE;
+    return add_node(c, (L2b_Node){(uint8_t)op, 0, x, y});
+}
+
+bool l2b_circuit_output(L2b_Circuit* c, L2b_Wire w, uint8_t qubit) {
+    if (w >= c->node_count) return false;
+    if (c->output_count == c->output_capacity) {
+        uint32_t capacity = c->output_capacity ? c->output_capacity * 2 : 16;
+        L2b_Output* grown = realloc(c->outputs, (size_t)capacity * sizeof(L2b_Output));
+        if (!grown) return false;
+        c->outputs = grown;
+        c->output_capacity = capacity;
+    }
+    c->outputs[c->output_count++] = (L2b_Output){w, qubit};
+    return true;
+}
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+// Depth-first post-order from the outputs, deeper operand first so the
+// shallow one is computed just before its use (fewer values live at once).
+// Returns the scheduled length; unreachable nodes are left out
+static uint32_t schedule(const L2b_Circuit* c, uint32_t* order, uint8_t* state,
+                         uint32_t* height, uint32_t* stack) {
+    for (uint32_t i = 0; i < c->node_count; i++) {
+        const L2b_Node* n = &c->nodes[i];
+        uint32_t hx = (n->op == L2B_NODE_INPUT) ? 0 : height[n->x];
+        uint32_t hy = (n->op == L2B_NODE_INPUT) ? 0 : height[n->y];
+        height[i] = (n->op == L2B_NODE_INPUT) ? 0 : 1 + (hx > hy ? hx : hy);
+    }
+
+    // state: 0 unvisited, 1 operands pending, 2 scheduled
+    uint32_t count = 0;
+    for (uint32_t o = 0; o < c->output_count; o++) {
+        uint32_t top = 0;
+        stack[top++] = c->outputs[o].wire;
+        while (top) {
+            uint32_t i = stack[top - 1];
+            const L2b_Node* n = &c->nodes[i];
+            if (state[i] == 2) {
+                top--;
+            } else if (state[i] == 1 || n->op == L2B_NODE_INPUT) {
+                state[i] = 2;
+                order[count++] = i;
+                top--;
+            } else {
+                state[i] = 1;
+                bool x_first = height[n->x] >= height[n->y];
+                stack[top++] = x_first ? n->y : n->x;
+                stack[top++] = x_first ? n->x : n->y;
+            }
+        }
+    }
+    return count;
+}
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+static inline R_Cell op_cell(uint8_t op, uint8_t a, uint8_t b, uint8_t result) {
+    return (R_Cell){(uint8_t)(L2A_GATE_DISSIPATIVE | op << 1), a, b, result};
+}
+
+bool l2b_circuit_compile(L2b_Circuit* c, uint8_t first_ancilla, uint32_t ancilla_count) {
+    circuit_reset(c);
+    if (ancilla_count > 256u - first_ancilla) ancilla_count = 256u - first_ancilla;
+
+    uint32_t n = c->node_count;
+    size_t words = (size_t)(n ? n : 1);
+    uint32_t* order = malloc(words * sizeof(uint32_t));
+    uint32_t* height = malloc(words * sizeof(uint32_t));
+    uint32_t* stack = malloc(2 * words * sizeof(uint32_t) + sizeof(uint32_t));
+    uint32_t* last_use = malloc(words * sizeof(uint32_t));
+    uint32_t* direct = malloc(words * sizeof(uint32_t));  // Output written in place
+    uint8_t* state = calloc(words, 1);
+    uint8_t* loc = malloc(words);
+    // Worst case: every gate, one stage per output, one copy per output
+    R_Cell* cells = malloc(((size_t)n + 2 * c->output_count + 1) * sizeof(R_Cell));
+    bool ok = order && height && stack && last_use && direct && state && loc && cells;
+
+    // Qubits read by inputs, and how many outputs name each qubit
+    uint64_t read[4] = {0};
+    uint8_t named[256] = {0};
+    for (uint32_t i = 0; ok && i < n; i++) {
+        if (c->nodes[i].op == L2B_NODE_INPUT) {
+            uint8_t q = c->nodes[i].qubit;
+            read[q >> 6] |= 1ULL << (q & 63);
+        }
+    }
+    for (uint32_t o = 0; ok && o < c->output_count; o++) {
+        uint8_t q = c->outputs[o].qubit;
+        if (named[q] < 2) named[q]++;
+    }
+
+    // Ancillas may not alias anything the circuit reads or writes
+    for (uint32_t k = 0; ok && k < ancilla_count; k++) {
+        uint8_t q = (uint8_t)(first_ancilla + k);
+        if (named[q] || ((read[q >> 6] >> (q & 63)) & 1)) ok = false;
+    }
+
+    uint32_t count = ok ? schedule(c, order, state, height, stack) : 0;
+
+    // A value lives until its last reader; outputs not written in place
+    // are copied at the end, so their values live to the end. An output
+    // qubit no input reads and no other output names is written in place
+    for (uint32_t i = 0; ok && i < n; i++) direct[i] = WIRE_NONE;
+    for (uint32_t p = 0; ok && p < count; p++) {
+        const L2b_Node* node = &c->nodes[order[p]];
+        last_use[order[p]] = 0;
+        if (node->op != L2B_NODE_INPUT) last_use[node->x] = last_use[node->y] = p;
+    }
+    for (uint32_t o = 0; ok && o < c->output_count; o++) {
+        L2b_Output out = c->outputs[o];
+        bool in_place = c->nodes[out.wire].op != L2B_NODE_INPUT && named[out.qubit] == 1 &&
+                        !((read[out.qubit >> 6] >> (out.qubit & 63)) & 1);
+        if (in_place && direct[out.wire] == WIRE_NONE) direct[out.wire] = o;
+        else last_use[out.wire] = LIVE_TO_END;
+    }
+
+    // Free ancillas as a stack, so recently freed (cache-warm) ones go first
+    uint8_t free_list[256];
+    uint32_t free_count = 0, next_ancilla = 0, emitted = 0;
+
+    // Inputs copied to another output qubit are staged in an ancilla up
+    // front when that qubit is itself written, so copies cannot chain
+    for (uint32_t o = 0; ok && o < c->output_count; o++) {
+        L2b_Wire w = c->outputs[o].wire;
+        const L2b_Node* node = &c->nodes[w];
+        if (node->op != L2B_NODE_INPUT || state[w] == 3 || !named[node->qubit]) continue;
+        if (next_ancilla == ancilla_count) {
+            ok = false;
+            break;
+        }
+        loc[w] = (uint8_t)(first_ancilla + next_ancilla++);
+        state[w] = 3;  // Staged
+        cells[emitted++] = op_cell(L2B_OP_OR, node->qubit, node->qubit, loc[w]);
+    }
+
+    for (uint32_t p = 0; ok && p < count; p++) {
+        uint32_t i = order[p];
+        const L2b_Node* node = &c->nodes[i];
+        if (node->op == L2B_NODE_INPUT) {
+            if (state[i] != 3) loc[i] = node->qubit;
+            continue;
+        }
+
+        // Operands dying here hand their ancilla to the result (the cell
+        // reads both operands before writing)
+        L2b_Wire operands[2] = {node->x, node->y};
+        for (uint32_t k = 0; k < (node->x == node->y ? 1u : 2u); k++) {
+            L2b_Wire w = operands[k];
+            bool ancilla = c->nodes[w].op != L2B_NODE_INPUT && direct[w] == WIRE_NONE;
+            if (ancilla && last_use[w] == p) free_list[free_count++] = loc[w];
+        }
+
+        if (direct[i] != WIRE_NONE) {
+            loc[i] = c->outputs[direct[i]].qubit;
+        } else if (free_count) {
+            loc[i] = free_list[--free_count];
+        } else if (next_ancilla < ancilla_count) {
+            loc[i] = (uint8_t)(first_ancilla + next_ancilla++);
+        } else {
+            ok = false;
+            break;
+        }
+        cells[emitted++] = op_cell(node->op, loc[node->x], loc[node->y], loc[i]);
+    }
+
+    for (uint32_t o = 0; ok && o < c->output_count; o++) {
+        L2b_Output out = c->outputs[o];
+        if (direct[out.wire] == o) continue;
+        cells[emitted++] = op_cell(L2B_OP_OR, loc[out.wire], loc[out.wire], out.qubit);
+    }
+
+    free(order);
+    free(height);
+    free(stack);
+    free(last_use);
+    free(direct);
+    free(state);
+    free(loc);
+    if (!ok) {
+        free(cells);
+        return false;
+    }
+
+    c->cells = cells;
+    c->cell_count = emitted;
+    c->ancillas_used = next_ancilla;
+    return true;
+}
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+// Threaded program for the state's backend, rebuilt when it changes
+static const L2a_Program* circuit_program(L2b_Circuit* c, Qubit_Backend_Type backend) {
+    if (!c->cells) return NULL;
+    if (c->program && c->program->backend == backend) return c->program;
+
+    l2a_program_free(c->program);
+    c->program = l2a_program_compile(c->cells, c->cell_count, backend);
+    return c->program;
+}
+
+bool l2b_circuit_eval(L2b_Circuit* c, Qubit_State* state) {
+    const L2a_Program* p = circuit_program(c, state->backend_type);
+    return p && l2a_program_run(p, state);
+}
+
+bool l2b_circuit_run(L2b_Runtime* r, L2b_Circuit* c) {
+    if (!c->cells) return false;
+    // A failed JIT compile runs nothing, so the threaded program covers it
+    if (r->l2a->jit && l2a_jit_run(r->l2a, c->cells, c->cell_count)) return true;
+
+    const L2a_Program* p = circuit_program(c, r->l2a->qubit_state->backend_type);
+    return p && l2a_run_program(r->l2a, p);
+}
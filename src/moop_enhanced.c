@@ -3,15 +3,90 @@
 
 #define _POSIX_C_SOURCE 200809L
 #include "moop_enhanced.h"
+#include "tape_simd.h"
+#include "gate_jit.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
 // ============================================================================
-// L2a: Tape-Loop Turing Machine (Enhancement 1)
+// L2a: Tape-Loop Turing Machine (Enhancement 1), Structure-of-Arrays Tape
 // ============================================================================
 
+// One zeroed block: cells | fitness | activity | last_used | essential bitmap.
+// size is a power of two >= 64, so every array starts 64-byte aligned
+static bool tape_alloc(L2a_Tape* t, uint32_t size) {
+    size_t bytes = (size_t)size * (sizeof(R_Cell) + 2 * sizeof(float) + sizeof(uint32_t)) +
+                   (size_t)(size / 64) * sizeof(uint64_t);
+    bytes = (bytes + 63) & ~(size_t)63;  // aligned_alloc wants a multiple of 64
+    uint8_t* block = aligned_alloc(64, bytes);
+    t->cells = (R_Cell*)block;
+    if (!block) return false;
+    memset(block, 0, bytes);
+
+    t->fitness = (float*)(block + (size_t)size * sizeof(R_Cell));
+    t->activity = t->fitness + size;
+    t->last_used = (uint32_t*)(t->activity + size);
+    t->essential = (uint64_t*)(t->last_used + size);
+    t->size = size;
+    t->mask = size - 1;
+    return true;
+}
+
+static inline bool tape_essential(const L2a_Tape* t, uint32_t i) {
+    return (t->essential[i >> 6] >> (i & 63)) & 1;
+}
+
+static inline void tape_set_essential(L2a_Tape* t, uint32_t i, bool essential) {
+    uint64_t bit = 1ULL << (i & 63);
+    t->essential[i >> 6] = essential ? (t->essential[i >> 6] | bit) : (t->essential[i >> 6] & ~bit);
+}
+
+// Double the tape. Each slot holds the newest op at a logical position
+// congruent to it, so entries move to (position & new_mask) and the head
+// lands on a slot no live entry maps to
+static bool tape_grow(L2a_Runtime* r) {
+    L2a_Tape* old = &r->tape;
+    if (old->size >= L2A_MAX_TAPE_SIZE) return false;
+
+    L2a_Tape grown;
+    if (!tape_alloc(&grown, old->size * 2)) return false;
+
+    float* scratch = realloc(r->prune_scratch, (size_t)grown.size * sizeof(float));
+    if (!scratch) {
+        free(grown.cells);
+        return false;
+    }
+    r->prune_scratch = scratch;
+
+    uint32_t newest = r->total_ops - 1;
+    for (uint32_t slot = 0; slot < old->size; slot++) {
+        uint32_t position = newest - ((newest - slot) & old->mask);
+        uint32_t dst = position & grown.mask;
+        grown.cells[dst] = old->cells[slot];
+        grown.fitness[dst] = old->fitness[slot];
+        grown.activity[dst] = old->activity[slot];
+        grown.last_used[dst] = old->last_used[slot];
+        tape_set_essential(&grown, dst, tape_essential(old, slot));
+    }
+
+    free(old->cells);
+    r->tape = grown;
+    r->tape_head = r->total_ops & grown.mask;
+    r->tape_wrapped = r->total_ops >= grown.size;
+    return true;
+}
+
 L2a_Runtime* l2a_init(uint32_t qubits, uint32_t instance_id, Qubit_Backend_Type backend) {
+    return l2a_init_sized(qubits, instance_id, backend, L1_TAPE_SIZE, false);
+}
+
+L2a_Runtime* l2a_init_sized(uint32_t qubits, uint32_t instance_id, Qubit_Backend_Type backend,
+                            uint32_t tape_size, bool growable) {
+    // Power-of-two capacity so slots are position & mask
+    uint32_t size = L2A_MIN_TAPE_SIZE;
+    while (size < tape_size && size < L2A_MAX_TAPE_SIZE) size <<= 1;
+
     L2a_Runtime* r = malloc(sizeof(L2a_Runtime));
     if (!r) return NULL;
 
@@ -22,28 +97,45 @@ L2a_Runtime* l2a_init(uint32_t qubits, uint32_t instance_id, Qubit_Backend_Type
         return NULL;
     }
 
-    r->tape = malloc(L1_TAPE_SIZE * sizeof(Tape_Entry));
-    if (!r->tape) {
+    r->prune_scratch = malloc((size_t)size * sizeof(float));
+    r->qubit_cache = calloc(qubits ? qubits : 1, sizeof(uint8_t));
+    if (!tape_alloc(&r->tape, size) || !r->prune_scratch || !r->qubit_cache) {
+        free(r->tape.cells);
+        free(r->prune_scratch);
+        free(r->qubit_cache);
         qubit_free(r->qubit_state);
         free(r);
         return NULL;
     }
-
-    // Initialize tape entries with zero fitness
-    for (uint32_t i = 0; i < L1_TAPE_SIZE; i++) {
-        r->tape[i].cell = (R_Cell){0, 0, 0, 0};
-        r->tape[i].fitness = 0.0f;
-        r->tape[i].last_used = 0;
-        r->tape[i].essential = false;
-    }
+    memset(r->qubit_dirty, 0, sizeof(r->qubit_dirty));
 
     r->qubit_count = qubits;
     r->tape_head = 0;
     r->instance_id = instance_id;
     r->total_ops = 0;
     r->tape_wrapped = false;
+    r->tape_growable = growable;
+    r->checkpoint_pending = false;
     r->pruning_cycles = 0;
     r->last_prune_op = 0;
+    r->fast_record = false;
+    r->reads_avoided = 0;
+    r->snapshots = NULL;
+    r->snapshot_count = 0;
+    r->snapshot_interval = 0;
+    r->snapshot_next = 0;
+    r->cow_saved = NULL;
+    r->cow_live = NULL;
+    r->cow_bytes = 0;
+    r->cow_shift = 0;
+    r->cow_active = false;
+    r->cow_position = 0;
+    r->cow_dirty = 0;
+    r->jit = NULL;
+    r->optimize = false;
+    r->opt_scratch = NULL;
+    r->opt_capacity = 0;
+    memset(&r->opt_stats, 0, sizeof(r->opt_stats));
 
     // Initialize default fitness parameters
     r->fitness_params.recency_weight = 0.5f;
@@ -56,39 +148,282 @@ L2a_Runtime* l2a_init(uint32_t qubits, uint32_t instance_id, Qubit_Backend_Type
 }
 
 void l2a_free(L2a_Runtime* r) {
+    l2a_set_snapshots(r, 0, 0);
+    free(r->cow_saved);
+    gate_jit_free(r->jit);
+    free(r->opt_scratch);
     qubit_free(r->qubit_state);
-    free(r->tape);
+    free(r->tape.cells);  // Base of the single tape allocation
+    free(r->prune_scratch);
+    free(r->qubit_cache);
     free(r);
 }
 
-// Helper: Record operation to circular tape with evolutionary pruning
-static void record_to_tape(L2a_Runtime* r, R_Cell cell) {
+// ============================================================================
+// Incremental Fitness State
+// ============================================================================
+
+static inline void mark_qubit_dirty(L2a_Runtime* r, uint8_t q) {
+    r->qubit_dirty[q >> 6] |= 1ULL << (q & 63);
+}
+
+// Activity from the qubit cache; same terms and order as l2a_compute_fitness
+static inline float cached_activity(const L2a_Runtime* r, R_Cell cell) {
+    float activity = 0.0f;
+    if (cell.a < r->qubit_count && r->qubit_cache[cell.a]) activity += 0.3f;
+    if (cell.b < r->qubit_count && r->qubit_cache[cell.b]) activity += 0.3f;
+    if (cell.c < r->qubit_count && r->qubit_cache[cell.c]) activity += 0.2f;
+    return activity;
+}
+
+static inline bool touches(const uint64_t* qubits, R_Cell cell) {
+    return ((qubits[cell.a >> 6] >> (cell.a & 63)) |
+            (qubits[cell.b >> 6] >> (cell.b & 63)) |
+            (qubits[cell.c >> 6] >> (cell.c & 63))) & 1;
+}
+
+// Read back only the dirty qubits, then refresh cached activity for the
+// entries that touch a qubit whose value actually changed
+static void sync_activity(L2a_Runtime* r) {
+    uint64_t changed[4] = {0};
+    bool any_changed = false;
+
+    for (uint32_t w = 0; w < 4; w++) {
+        uint64_t bits = r->qubit_dirty[w];
+        r->qubit_dirty[w] = 0;
+        while (bits) {
+            uint32_t q = w * 64 + (uint32_t)__builtin_ctzll(bits);
+            bits &= bits - 1;
+            if (q >= r->qubit_count) continue;
+
+            uint8_t value = qubit_read(r->qubit_state, (uint8_t)q) != 0;
+            if (value != r->qubit_cache[q]) {
+                r->qubit_cache[q] = value;
+                changed[w] |= 1ULL << (q & 63);
+                any_changed = true;
+            }
+        }
+    }
+
+    if (!any_changed) return;
+
+    for (uint32_t i = 0; i < r->tape.size; i++) {
+        if (touches(changed, r->tape.cells[i])) {
+            r->tape.activity[i] = cached_activity(r, r->tape.cells[i]);
+        }
+    }
+}
+
+// Weighted fitness for an entry given its activity; recency comes from
+// last_used at evaluation time, so nothing has to age entries between cycles
+static inline float fitness_from_activity(const L2a_Runtime* r, uint32_t index,
+                                          float qubit_activity) {
+    // Essential entries get max fitness (never pruned)
+    if (tape_essential(&r->tape, index)) return 1.0f;
+
+    return r->fitness_params.recency_weight * tape_recency(r->total_ops - r->tape.last_used[index]) +
+           r->fitness_params.activity_weight * qubit_activity +
+           r->fitness_params.gate_weight * tape_gate_priority(r->tape.cells[index].gate);
+}
+
+// ============================================================================
+// State Snapshots
+// ============================================================================
+
+bool l2a_set_snapshots(L2a_Runtime* r, uint32_t interval, uint32_t count) {
+    for (uint32_t i = 0; i < r->snapshot_count; i++) {
+        qubit_free(r->snapshots[i].state);
+    }
+    free(r->snapshots);
+    r->snapshots = NULL;
+    r->snapshot_count = 0;
+    r->snapshot_interval = 0;
+    r->snapshot_next = 0;
+    if (count == 0) return true;
+
+    L2a_Snapshot* snapshots = calloc(count, sizeof(L2a_Snapshot));
+    if (!snapshots) return false;
+    for (uint32_t i = 0; i < count; i++) {
+        // Preallocate every copy so taking a snapshot never allocates
+        snapshots[i].state = qubit_clone(r->qubit_state);
+        if (!snapshots[i].state) {
+            while (i--) qubit_free(snapshots[i].state);
+            free(snapshots);
+            return false;
+        }
+    }
+
+    r->snapshots = snapshots;
+    r->snapshot_count = count;
+    r->snapshot_interval = interval;
+    return true;
+}
+
+static void take_snapshot(L2a_Runtime* r) {
+    // A periodic snapshot may already cover this position
+    uint32_t last = (r->snapshot_next ? r->snapshot_next : r->snapshot_count) - 1;
+    if (r->snapshots[last].valid && r->snapshots[last].position == r->total_ops) return;
+
+    L2a_Snapshot* s = &r->snapshots[r->snapshot_next];
+    qubit_copy(s->state, r->qubit_state);
+    s->position = r->total_ops;
+    s->valid = true;
+    r->snapshot_next = (r->snapshot_next + 1) % r->snapshot_count;
+}
+
+// Snapshot closest to target among those whose replay ops are still on the
+// tape, or NULL if rewinding gate by gate is no more work
+static const L2a_Snapshot* nearest_snapshot(const L2a_Runtime* r, uint32_t target,
+                                            uint32_t steps) {
+    uint32_t history = (r->total_ops < r->tape.size) ? r->total_ops : r->tape.size;
+    uint32_t oldest = r->total_ops - history;
+
+    const L2a_Snapshot* best = NULL;
+    uint32_t best_distance = steps;
+    for (uint32_t i = 0; i < r->snapshot_count; i++) {
+        const L2a_Snapshot* s = &r->snapshots[i];
+        if (!s->valid || s->position < oldest || s->position > r->total_ops) continue;
+
+        uint32_t distance = (s->position > target) ? s->position - target : target - s->position;
+        // The copy costs about one gate on a statevector
+        if (distance + 1 < best_distance) {
+            best = s;
+            best_distance = distance + 1;
+        }
+    }
+    return best;
+}
+
+// ============================================================================
+// Copy-on-Write Checkpoints
+// ============================================================================
+
+bool l2a_set_cow_checkpoints(L2a_Runtime* r, bool enabled) {
+    free(r->cow_saved);
+    r->cow_saved = NULL;
+    r->cow_active = false;
+    r->cow_dirty = 0;
+    if (!enabled) return true;
+
+    Qubit_State* s = r->qubit_state;
+    switch (s->backend_type) {
+        case QUBIT_BACKEND_CLASSICAL:
+            r->cow_live = QUBIT_CLASSICAL_BITS(s);
+            r->cow_bytes = s->qubit_count;
+            r->cow_shift = 0;
+            break;
+        case QUBIT_BACKEND_PACKED:
+            r->cow_live = (uint8_t*)QUBIT_PACKED_WORDS(s);
+            r->cow_bytes = ((Packed_Qubit_State*)s->backend_data)->word_count * sizeof(uint64_t);
+            r->cow_shift = 3;
+            break;
+        default:
+            return false;  // No flat bit storage to copy
+    }
+
+    // Gate operands are uint8_t, so at most 32 words are ever written
+    r->cow_saved = malloc((r->cow_bytes + 7) & ~7u);
+    return r->cow_saved != NULL;
+}
+
+// Save the word holding qubit q before its first write since the checkpoint
+static inline void cow_touch(L2a_Runtime* r, uint8_t q) {
+    if (!r->cow_active) return;
+
+    uint32_t word = (uint32_t)(q >> r->cow_shift) >> 3;
+    uint32_t offset = word * 8;
+    if ((r->cow_dirty & (1ULL << word)) || offset >= r->cow_bytes) return;
+    r->cow_dirty |= 1ULL << word;
+
+    uint32_t len = (r->cow_bytes - offset < 8) ? r->cow_bytes - offset : 8;
+    memcpy(r->cow_saved + offset, r->cow_live + offset, len);
+}
+
+// Copy the dirty words back; the checkpoint stays restorable
+static void cow_revert(L2a_Runtime* r) {
+    uint64_t dirty = r->cow_dirty;
+    r->cow_dirty = 0;
+    while (dirty) {
+        uint32_t word = (uint32_t)__builtin_ctzll(dirty);
+        dirty &= dirty - 1;
+
+        uint32_t offset = word * 8;
+        uint32_t len = (r->cow_bytes - offset < 8) ? r->cow_bytes - offset : 8;
+        memcpy(r->cow_live + offset, r->cow_saved + offset, len);
+
+        // Qubits stored in the word, for the next activity sync
+        uint32_t first = offset << r->cow_shift;
+        uint32_t last = (offset + len) << r->cow_shift;
+        for (uint32_t q = first; q < last && q < 256; q++) mark_qubit_dirty(r, (uint8_t)q);
+    }
+}
+
+// Fixed-backend builds inline recording into every L2a gate, so a gate is
+// the bare bit kernel plus the tape write with no calls in between
+#ifdef MOOP_FIXED_BACKEND
+#define L2A_RECORD_INLINE static inline __attribute__((always_inline))
+#else
+#define L2A_RECORD_INLINE static
+#endif
+
+// Write one op to the tape head; false if selection discarded it
+L2A_RECORD_INLINE bool record_cell(L2a_Runtime* r, R_Cell cell) {
+    // The op recorded right after l2a_checkpoint claims the marked slot
+    bool checkpoint = r->checkpoint_pending;
+    r->checkpoint_pending = false;
+
+    // Growable tapes make room rather than skip an essential entry
+    if (!checkpoint && r->tape_growable && tape_essential(&r->tape, r->tape_head)) {
+        tape_grow(r);
+    }
+
     uint32_t target_index = r->tape_head;
+    L2a_Tape* t = &r->tape;
+    R_Cell existing = t->cells[target_index];
 
     // Compute fitness for new operation
-    float new_fitness = l2a_compute_fitness(r, target_index);
-
-    // Check if existing entry should be protected
-    Tape_Entry* existing = &r->tape[target_index];
+    float new_fitness;
+    if (r->fast_record) {
+        // Recency is 1.0 for the op being recorded; activity waits for prune
+        new_fitness = r->fitness_params.recency_weight +
+                      r->fitness_params.gate_weight * tape_gate_priority(cell.gate);
+        r->reads_avoided += (existing.a < r->qubit_count) +
+                            (existing.b < r->qubit_count) +
+                            (existing.c < r->qubit_count);
+    } else {
+        new_fitness = l2a_compute_fitness(r, target_index);
+    }
 
     // Evolutionary selection: only overwrite if new op has higher fitness
     // OR if existing entry is not essential
-    if (!existing->essential && (new_fitness >= existing->fitness || !r->tape_wrapped)) {
-        r->tape[target_index].cell = cell;
-        r->tape[target_index].fitness = new_fitness;
-        r->tape[target_index].last_used = r->total_ops;
-        r->tape[target_index].essential = false;
-    } else if (new_fitness < existing->fitness && r->tape_wrapped) {
-        // Skip recording (pruned) - low fitness operation discarded
-        return;
+    bool essential = tape_essential(t, target_index);
+    if (checkpoint || (!essential && (new_fitness >= t->fitness[target_index] || !r->tape_wrapped))) {
+        t->cells[target_index] = cell;
+        t->fitness[target_index] = checkpoint ? 1.0f : new_fitness;
+        t->activity[target_index] = cached_activity(r, cell);
+        t->last_used[target_index] = r->total_ops;
+    } else {
+        // Skip recording (pruned) - low fitness operation discarded, or an
+        // essential entry the tape could not grow past
+        return false;
     }
 
-    r->tape_head = (r->tape_head + 1) % L1_TAPE_SIZE;  // Wrap around
+    r->tape_head = (r->tape_head + 1) & t->mask;  // Wrap around
     r->total_ops++;
 
     if (r->tape_head == 0 && r->total_ops > 0) {
         r->tape_wrapped = true;  // Tape has wrapped
     }
+    return true;
+}
+
+// Helper: Record operation to circular tape with evolutionary pruning
+L2A_RECORD_INLINE void record_to_tape(L2a_Runtime* r, R_Cell cell) {
+    if (!record_cell(r, cell)) return;
+
+    if (r->snapshot_interval && r->total_ops % r->snapshot_interval == 0) {
+        take_snapshot(r);
+    }
 
     // Trigger evolutionary pruning based on adaptive interval
     if (r->total_ops - r->last_prune_op >= r->fitness_params.prune_interval) {
@@ -99,58 +434,377 @@ static void record_to_tape(L2a_Runtime* r, R_Cell cell) {
 // The 4 reversible primitives (with tape recording)
 
 void l2a_CCNOT(L2a_Runtime* r, uint8_t a, uint8_t b, uint8_t c) {
+    cow_touch(r, c);
     qubit_CCNOT(r->qubit_state, a, b, c);
+    mark_qubit_dirty(r, c);
     record_to_tape(r, (R_Cell){0, a, b, c});
 }
 
 void l2a_CNOT(L2a_Runtime* r, uint8_t a, uint8_t b) {
+    cow_touch(r, b);
     qubit_CNOT(r->qubit_state, a, b);
+    mark_qubit_dirty(r, b);
     record_to_tape(r, (R_Cell){1, a, b, 0});
 }
 
 void l2a_NOT(L2a_Runtime* r, uint8_t a) {
+    cow_touch(r, a);
     qubit_NOT(r->qubit_state, a);
+    mark_qubit_dirty(r, a);
     record_to_tape(r, (R_Cell){2, a, 0, 0});
 }
 
 void l2a_SWAP(L2a_Runtime* r, uint8_t a, uint8_t b) {
+    cow_touch(r, a);
+    cow_touch(r, b);
     qubit_SWAP(r->qubit_state, a, b);
+    mark_qubit_dirty(r, a);
+    mark_qubit_dirty(r, b);
     record_to_tape(r, (R_Cell){3, a, b, 0});
 }
 
+// ============================================================================
+// Batched Gate Submission
+// ============================================================================
+
+// Free slots from the head that record_cell would fill unconditionally:
+// tape not yet wrapped, no pending checkpoint, no essential entry, and no
+// wrap to slot 0 inside the run
+static uint32_t free_run(const L2a_Runtime* r, uint32_t max) {
+    if (r->tape_wrapped || r->checkpoint_pending) return 0;
+
+    uint32_t run = r->tape.size - r->tape_head;
+    if (run > max) run = max;
+    for (uint32_t k = 0; k < run; k++) {
+        if (tape_essential(&r->tape, r->tape_head + k)) return k;
+    }
+    return run;
+}
+
+// record_cell for a free run: same fitness per slot, one bulk cell copy
+static void record_run(L2a_Runtime* r, const R_Cell* cells, uint32_t n) {
+    L2a_Tape* t = &r->tape;
+    uint32_t head = r->tape_head;
+
+    for (uint32_t k = 0; k < n; k++) {
+        R_Cell existing = t->cells[head + k];
+        if (r->fast_record) {
+            t->fitness[head + k] = r->fitness_params.recency_weight +
+                                   r->fitness_params.gate_weight * tape_gate_priority(cells[k].gate);
+            r->reads_avoided += (existing.a < r->qubit_count) +
+                                (existing.b < r->qubit_count) +
+                                (existing.c < r->qubit_count);
+        } else {
+            t->fitness[head + k] = l2a_compute_fitness(r, head + k);
+        }
+        t->last_used[head + k] = r->total_ops++;
+    }
+
+    memcpy(&t->cells[head], cells, (size_t)n * sizeof(R_Cell));
+    for (uint32_t k = 0; k < n; k++) {
+        t->activity[head + k] = cached_activity(r, cells[k]);
+    }
+
+    r->tape_head = (head + n) & t->mask;
+    if (r->tape_head == 0) r->tape_wrapped = true;
+}
+
+// Every gate in one backend dispatch. Written qubits are saved for
+// copy-on-write and marked dirty up front, before any gate runs.
+// Dissipative cells get the bit they overwrote stored back into their gate
+static void apply_batch(L2a_Runtime* r, R_Cell* cells, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        R_Cell c = cells[i];
+        uint8_t written = (c.gate == 0 || l2a_is_dissipative(c.gate)) ? c.c :
+                          (c.gate == 1) ? c.b : c.a;
+        cow_touch(r, written);
+        mark_qubit_dirty(r, written);
+        if (c.gate == 3) {
+            cow_touch(r, c.b);
+            mark_qubit_dirty(r, c.b);
+        }
+    }
+
+    Qubit_State* s = r->qubit_state;
+    if (QUBIT_IS_CLASSICAL(s)) {
+        uint8_t* bits = QUBIT_CLASSICAL_BITS(s);
+        for (uint32_t i = 0; i < n; i++) {
+            R_Cell c = cells[i];
+            switch (c.gate) {
+                case 0: classical_bits_CCNOT(bits, c.a, c.b, c.c); break;
+                case 1: classical_bits_CNOT(bits, c.a, c.b); break;
+                case 2: classical_bits_NOT(bits, c.a); break;
+                case 3: classical_bits_SWAP(bits, c.a, c.b); break;
+                default:
+                    if (l2a_is_dissipative(c.gate)) {
+                        uint8_t value = l2b_op_eval((c.gate & 0x0F) >> 1, bits[c.a], bits[c.b]);
+                        cells[i].gate = (uint8_t)((c.gate & ~1) | classical_bits_SET(bits, c.c, value));
+                    }
+                    break;
+            }
+        }
+    } else if (QUBIT_IS_PACKED(s)) {
+        uint64_t* words = QUBIT_PACKED_WORDS(s);
+        for (uint32_t i = 0; i < n; i++) {
+            R_Cell c = cells[i];
+            switch (c.gate) {
+                case 0: packed_words_CCNOT(words, c.a, c.b, c.c); break;
+                case 1: packed_words_CNOT(words, c.a, c.b); break;
+                case 2: packed_words_NOT(words, c.a); break;
+                case 3: packed_words_SWAP(words, c.a, c.b); break;
+                default:
+                    if (l2a_is_dissipative(c.gate)) {
+                        uint8_t value = l2b_op_eval((c.gate & 0x0F) >> 1,
+                                                    (uint8_t)packed_words_get(words, c.a),
+                                                    (uint8_t)packed_words_get(words, c.b));
+                        cells[i].gate = (uint8_t)((c.gate & ~1) | packed_words_SET(words, c.c, value));
+                    }
+                    break;
+            }
+        }
+    } else {
+        const Qubit_Backend_Ops* ops = s->ops;
+        for (uint32_t i = 0; i < n; i++) {
+            R_Cell c = cells[i];
+            switch (c.gate) {
+                case 0: ops->CCNOT(s, c.a, c.b, c.c); break;
+                case 1: ops->CNOT(s, c.a, c.b); break;
+                case 2: ops->NOT(s, c.a); break;
+                case 3: ops->SWAP(s, c.a, c.b); break;
+                default:
+                    if (l2a_is_dissipative(c.gate)) {
+                        uint8_t old = ops->read(s, c.c);
+                        if (old != l2b_op_eval((c.gate & 0x0F) >> 1, ops->read(s, c.a), ops->read(s, c.b))) {
+                            ops->NOT(s, c.c);
+                        }
+                        cells[i].gate = (uint8_t)((c.gate & ~1) | old);
+                    }
+                    break;
+            }
+        }
+    }
+}
+
+void l2a_set_optimize(L2a_Runtime* r, bool enabled) {
+    r->optimize = enabled;
+    if (!enabled) {
+        free(r->opt_scratch);
+        r->opt_scratch = NULL;
+        r->opt_capacity = 0;
+    }
+}
+
+// Copies cells into the runtime's scratch buffer (NULL if it cannot grow)
+static R_Cell* scratch_cells(L2a_Runtime* r, const R_Cell* cells, uint32_t n) {
+    if (n > r->opt_capacity) {
+        R_Cell* grown = realloc(r->opt_scratch, (size_t)n * sizeof(R_Cell));
+        if (!grown) return NULL;
+        r->opt_scratch = grown;
+        r->opt_capacity = n;
+    }
+    if (cells != r->opt_scratch) memcpy(r->opt_scratch, cells, (size_t)n * sizeof(R_Cell));
+    return r->opt_scratch;
+}
+
+const R_Cell* l2a_optimize_cells(L2a_Runtime* r, const R_Cell* cells, uint32_t* n) {
+    if (!r->optimize || *n == 0) return cells;
+    if (!scratch_cells(r, cells, *n)) return cells;  // Unoptimized is still correct
+
+    L2a_Opt_Stats stats;
+    *n = l2a_optimize(r->opt_scratch, *n, &stats);
+    r->opt_stats.input_gates += stats.input_gates;
+    r->opt_stats.output_gates += stats.output_gates;
+    r->opt_stats.cancelled += stats.cancelled;
+    r->opt_stats.swaps_merged += stats.swaps_merged;
+    return r->opt_scratch;
+}
+
+static bool has_dissipative(const R_Cell* cells, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (l2a_is_dissipative(cells[i].gate)) return true;
+    }
+    return false;
+}
+
+void l2a_execute_batch(L2a_Runtime* r, const R_Cell* cells, uint32_t n) {
+    cells = l2a_optimize_cells(r, cells, &n);
+    if (n == 0) return;
+    uint32_t start = r->total_ops;
+
+    // Dissipative cells store the bit they overwrite, so a batch holding any
+    // runs on a writable copy (the optimizer's output already is one)
+    R_Cell* run = (R_Cell*)cells;  // Written only for dissipative cells
+    if (cells != r->opt_scratch && has_dissipative(cells, n) &&
+        !(run = scratch_cells(r, cells, n))) {
+        // No copy: one cell at a time through a local
+        for (uint32_t i = 0; i < n; i++) {
+            R_Cell c = cells[i];
+            apply_batch(r, &c, 1);
+            record_cell(r, c);
+        }
+    } else {
+        apply_batch(r, run, n);
+
+        // Contiguous free runs are copied in bulk; slots that need selection,
+        // growth or a checkpoint mark go through record_cell one by one
+        for (uint32_t i = 0; i < n;) {
+            uint32_t span = free_run(r, n - i);
+            if (span) {
+                record_run(r, run + i, span);
+                i += span;
+            } else {
+                record_cell(r, run[i++]);
+            }
+        }
+    }
+
+    // Triggers once per batch: a snapshot if an interval boundary passed
+    if (r->snapshot_interval &&
+        r->total_ops / r->snapshot_interval != start / r->snapshot_interval) {
+        take_snapshot(r);
+    }
+
+    if (r->total_ops - r->last_prune_op >= r->fitness_params.prune_interval) {
+        l2a_prune_tape(r);
+    }
+}
+
+void l2a_touch_written(L2a_Runtime* r, const uint64_t written[4]) {
+    for (uint32_t w = 0; w < 4; w++) {
+        uint64_t bits = written[w];
+        r->qubit_dirty[w] |= bits;
+        while (bits) {
+            cow_touch(r, (uint8_t)(w * 64 + (uint32_t)__builtin_ctzll(bits)));
+            bits &= bits - 1;
+        }
+    }
+}
+
+bool l2a_run_program(L2a_Runtime* r, const L2a_Program* p) {
+    if (!p || p->backend != r->qubit_state->backend_type) return false;
+
+    l2a_touch_written(r, p->written);
+    return l2a_program_run(p, r->qubit_state);
+}
+
 // Reversibility (tape-loop aware)
 uint32_t l2a_checkpoint(L2a_Runtime* r) {
-    uint32_t checkpoint_pos = r->tape_head;
+    // The next op overwrites the head slot; keep any essential entry there
+    // (a pending checkpoint's own mark is not one)
+    if (r->tape_growable && !r->checkpoint_pending && tape_essential(&r->tape, r->tape_head)) {
+        tape_grow(r);
+    }
+
+    // Mark checkpoint as essential (never prune); the next recorded op
+    // claims the slot and keeps the mark
+    l2a_mark_essential(r, r->tape_head);
+    r->checkpoint_pending = true;
+
+    if (r->snapshots) take_snapshot(r);
 
-    // Mark checkpoint as essential (never prune)
-    l2a_mark_essential(r, checkpoint_pos);
+    // Copy-on-write: the live words are the checkpoint until first written
+    if (r->cow_saved) {
+        r->cow_active = true;
+        r->cow_position = r->total_ops;
+        r->cow_dirty = 0;
+    }
+
+    return r->total_ops;  // Logical position (stable across tape growth)
+}
 
-    return checkpoint_pos;  // Return current tape position
+// Reversible gates are self-inverse, so undo and redo run the same gate.
+// A dissipative op is recomputed forward and restores its saved bit back
+static inline void replay_cell(L2a_Runtime* r, uint32_t position, bool forward) {
+    R_Cell c = r->tape.cells[position & r->tape.mask];
+    switch(c.gate) {
+        case 0: qubit_CCNOT(r->qubit_state, c.a, c.b, c.c); break;
+        case 1: qubit_CNOT(r->qubit_state, c.a, c.b); break;
+        case 2: qubit_NOT(r->qubit_state, c.a); break;
+        case 3: qubit_SWAP(r->qubit_state, c.a, c.b); break;
+        default:
+            if (l2a_is_dissipative(c.gate)) {
+                uint8_t value = forward ? l2b_op_eval((c.gate & 0x0F) >> 1,
+                                                      qubit_read(r->qubit_state, c.a),
+                                                      qubit_read(r->qubit_state, c.b))
+                                        : (c.gate & 1);
+                if (qubit_read(r->qubit_state, c.c) != value) qubit_NOT(r->qubit_state, c.c);
+            }
+            break;
+    }
+    mark_qubit_dirty(r, c.a);
+    mark_qubit_dirty(r, c.b);
+    mark_qubit_dirty(r, c.c);
 }
 
 void l2a_restore(L2a_Runtime* r, uint32_t checkpoint) {
+    // History older than one tape length has been overwritten
+    uint32_t steps = (checkpoint < r->total_ops) ? r->total_ops - checkpoint : 0;
+    if (steps > r->tape.size) steps = r->tape.size;
+    uint32_t target = r->total_ops - steps;
+
+    // Latest copy-on-write checkpoint: copy back the words written since.
+    // Otherwise jump to the nearest snapshot and replay the ops between it
+    // and the target, or execute inverses back from the current state
+    const L2a_Snapshot* from = NULL;
+    if (r->cow_active && target == r->cow_position) {
+        cow_revert(r);
+    } else if ((from = nearest_snapshot(r, target, steps))) {
+        qubit_copy(r->qubit_state, from->state);
+        memset(r->qubit_dirty, 0xff, sizeof(r->qubit_dirty));
+        for (uint32_t p = from->position; p < target; p++) replay_cell(r, p, true);
+        for (uint32_t p = from->position; p > target; p--) replay_cell(r, p - 1, false);
+    } else {
+        for (uint32_t p = r->total_ops; p > target; p--) replay_cell(r, p - 1, false);
+    }
+
+    // Rewinding past the copy-on-write checkpoint leaves nothing to copy
+    // back to (replayed gates only touch words already dirty)
+    if (target < r->cow_position) r->cow_active = false;
+
+    // A checkpoint still pending at the head marks no op: drop it with the
+    // undone ones (unless the rewind wraps back onto its slot), or the next
+    // recorded op would find an essential slot. Restoring to the head itself
+    // keeps it armed
+    bool checkpoint_slot = r->checkpoint_pending;
+    if (r->checkpoint_pending && steps && steps < r->tape.size) {
+        tape_set_essential(&r->tape, r->tape_head, false);
+    }
+    r->checkpoint_pending = false;
+
     // Rewind tape head to checkpoint
-    while (r->tape_head != checkpoint) {
+    while (steps--) {
         // Move backward
-        r->tape_head = (r->tape_head == 0) ? L1_TAPE_SIZE - 1 : r->tape_head - 1;
-
-        // Execute inverse using backend API (reversible gates are self-inverse)
-        R_Cell c = r->tape[r->tape_head].cell;
-        switch(c.gate) {
-            case 0: qubit_CCNOT(r->qubit_state, c.a, c.b, c.c); break;
-            case 1: qubit_CNOT(r->qubit_state, c.a, c.b); break;
-            case 2: qubit_NOT(r->qubit_state, c.a); break;
-            case 3: qubit_SWAP(r->qubit_state, c.a, c.b); break;
-        }
+        r->tape_head = (r->tape_head - 1) & r->tape.mask;
+
+        // Undone ops are dead history: drop checkpoint marks past the target
+        checkpoint_slot = tape_essential(&r->tape, r->tape_head);
+        tape_set_essential(&r->tape, r->tape_head, false);
 
         r->total_ops--;
     }
+
+    // Snapshots past the target describe undone history
+    for (uint32_t i = 0; i < r->snapshot_count; i++) {
+        if (r->snapshots[i].position > target) r->snapshots[i].valid = false;
+    }
+
+    // Restoring to a checkpoint re-arms it for the next recorded op
+    if (checkpoint_slot) {
+        l2a_mark_essential(r, r->tape_head);
+        r->checkpoint_pending = true;
+    }
 }
 
 const char* l2a_print(R_Cell c) {
     static char buf[64];
     const char* gates[] = {"CCNOT", "CNOT", "NOT", "SWAP"};
-    sprintf(buf, "%s %d %d %d", gates[c.gate], c.a, c.b, c.c);
+    const char* ops[] = {"AND", "OR", "XOR", "NAND", "NOR"};
+    if (l2a_is_dissipative(c.gate)) {
+        sprintf(buf, "%s %d %d %d (was %d)", ops[(c.gate & 0x0F) >> 1], c.a, c.b, c.c,
+                c.gate & 1);
+    } else {
+        sprintf(buf, "%s %d %d %d", c.gate < 4 ? gates[c.gate] : "?", c.a, c.b, c.c);
+    }
     return buf;
 }
 
@@ -159,12 +813,15 @@ const char* l2a_print(R_Cell c) {
 // ============================================================================
 
 R_Cell l2a_read_tape(L2a_Runtime* r, uint32_t index) {
-    return r->tape[index % L1_TAPE_SIZE].cell;
+    return r->tape.cells[index & r->tape.mask];
 }
 
 void l2a_write_tape(L2a_Runtime* r, uint32_t index, R_Cell cell) {
-    r->tape[index % L1_TAPE_SIZE].cell = cell;
-    r->tape[index % L1_TAPE_SIZE].last_used = r->total_ops;
+    index &= r->tape.mask;
+    if (r->jit) gate_jit_invalidate(r->jit, index, r->tape.mask);
+    r->tape.cells[index] = cell;
+    r->tape.activity[index] = cached_activity(r, cell);
+    r->tape.last_used[index] = r->total_ops;
 }
 
 void l2a_meta_modify(L2a_Runtime* r, R_Cell* modification_rule, uint32_t rule_len) {
@@ -173,10 +830,13 @@ void l2a_meta_modify(L2a_Runtime* r, R_Cell* modification_rule, uint32_t rule_le
         R_Cell rule = modification_rule[i];
         // Interpret rule as: "modify tape cell at position rule.a"
         if (rule.gate == 0) {  // CCNOT used as modify instruction
-            R_Cell target = r->tape[rule.a].cell;
+            uint32_t index = rule.a & r->tape.mask;
+            if (r->jit) gate_jit_invalidate(r->jit, index, r->tape.mask);
+            R_Cell target = r->tape.cells[index];
             target.gate = rule.b;  // Change gate type
-            r->tape[rule.a].cell = target;
-            r->tape[rule.a].last_used = r->total_ops;
+            r->tape.cells[index] = target;
+            r->tape.activity[index] = cached_activity(r, target);
+            r->tape.last_used[index] = r->total_ops;
         }
     }
 }
@@ -190,74 +850,106 @@ void l2a_meta_modify(L2a_Runtime* r, R_Cell* modification_rule, uint32_t rule_le
 // 2. Qubit dependency (operations on "active" qubits)
 // 3. Gate type (some operations more fundamental than others)
 float l2a_compute_fitness(L2a_Runtime* r, uint32_t index) {
-    Tape_Entry* entry = &r->tape[index];
+    R_Cell cell = r->tape.cells[index];
 
-    // Component 1: Recency (0.0-1.0, exponential decay)
-    uint32_t age = r->total_ops - entry->last_used;
-    float recency = (age == 0) ? 1.0f : (1.0f / (1.0f + age / 100.0f));
-
-    // Component 2: Qubit dependency (operations on non-zero qubits are "hotter")
+    // Qubit dependency (operations on non-zero qubits are "hotter"), read live
     float qubit_activity = 0.0f;
-    if (entry->cell.a < r->qubit_count && qubit_read(r->qubit_state, entry->cell.a)) qubit_activity += 0.3f;
-    if (entry->cell.b < r->qubit_count && qubit_read(r->qubit_state, entry->cell.b)) qubit_activity += 0.3f;
-    if (entry->cell.c < r->qubit_count && qubit_read(r->qubit_state, entry->cell.c)) qubit_activity += 0.2f;
-
-    // Component 3: Gate type priority (CCNOT > CNOT > SWAP > NOT)
-    float gate_priority = 0.0f;
-    switch (entry->cell.gate) {
-        case 0: gate_priority = 0.4f; break;  // CCNOT (universal gate)
-        case 1: gate_priority = 0.3f; break;  // CNOT
-        case 3: gate_priority = 0.2f; break;  // SWAP
-        case 2: gate_priority = 0.1f; break;  // NOT
-    }
+    if (cell.a < r->qubit_count && qubit_read(r->qubit_state, cell.a)) qubit_activity += 0.3f;
+    if (cell.b < r->qubit_count && qubit_read(r->qubit_state, cell.b)) qubit_activity += 0.3f;
+    if (cell.c < r->qubit_count && qubit_read(r->qubit_state, cell.c)) qubit_activity += 0.2f;
 
-    // Weighted sum: use adaptive fitness parameters
-    float fitness = r->fitness_params.recency_weight * recency +
-                    r->fitness_params.activity_weight * qubit_activity +
-                    r->fitness_params.gate_weight * gate_priority;
+    return fitness_from_activity(r, index, qubit_activity);
+}
 
-    // Essential entries get max fitness (never pruned)
-    if (entry->essential) {
-        fitness = 1.0f;
-    }
+void l2a_compute_fitness_batch(L2a_Runtime* r) {
+    sync_activity(r);
+    tape_kernels()->batch_fitness(&r->tape, r->tape.size, r->total_ops, &r->fitness_params);
+}
 
-    return fitness;
+void l2a_set_fast_record(L2a_Runtime* r, bool enabled) {
+    r->fast_record = enabled;
 }
 
 void l2a_mark_essential(L2a_Runtime* r, uint32_t index) {
-    r->tape[index % L1_TAPE_SIZE].essential = true;
-    r->tape[index % L1_TAPE_SIZE].fitness = 1.0f;
+    index &= r->tape.mask;
+    tape_set_essential(&r->tape, index, true);
+    r->tape.fitness[index] = 1.0f;
 }
 
-void l2a_prune_tape(L2a_Runtime* r) {
-    // Evolutionary pruning: compact high-fitness entries, discard low-fitness
+// Quickselect: the k-th largest value (0-based) of v[0..n), reordering v
+static float select_kth_largest(float* v, uint32_t n, uint32_t k) {
+    uint32_t lo = 0, hi = n - 1;
+
+    while (lo < hi) {
+        // Median-of-three pivot keeps sorted or constant tapes linear
+        uint32_t mid = lo + (hi - lo) / 2;
+        float a = v[lo], b = v[mid], c = v[hi];
+        float pivot = (a > b) ? ((b > c) ? b : (a > c ? c : a))
+                              : ((a > c) ? a : (b > c ? c : b));
+
+        // Hoare partition, descending: [lo..j] >= pivot >= [i..hi]
+        uint32_t i = lo, j = hi;
+        while (i <= j) {
+            while (v[i] > pivot) i++;
+            while (v[j] < pivot) j--;
+            if (i <= j) {
+                float t = v[i];
+                v[i] = v[j];
+                v[j] = t;
+                i++;
+                if (j == 0) break;
+                j--;
+            }
+        }
 
-    // 1. Recompute fitness for all entries
-    for (uint32_t i = 0; i < L1_TAPE_SIZE; i++) {
-        if (!r->tape[i].essential) {
-            r->tape[i].fitness = l2a_compute_fitness(r, i);
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            return v[k];
         }
     }
 
-    // 2. Sort entries by fitness (selection pressure)
-    // For simplicity: bubble sort (good enough for 1024 entries)
-    for (uint32_t i = 0; i < L1_TAPE_SIZE - 1; i++) {
-        for (uint32_t j = 0; j < L1_TAPE_SIZE - i - 1; j++) {
-            if (r->tape[j].fitness < r->tape[j + 1].fitness) {
-                Tape_Entry temp = r->tape[j];
-                r->tape[j] = r->tape[j + 1];
-                r->tape[j + 1] = temp;
-            }
+    return v[k];
+}
+
+void l2a_prune_tape(L2a_Runtime* r) {
+    // Evolutionary pruning: keep the top prune_threshold fraction by fitness,
+    // reset the rest in place (tape positions never move)
+
+    // 1. Refresh fitness from cached activity (reads only changed qubits)
+    L2a_Tape* t = &r->tape;
+    l2a_compute_fitness_batch(r);
+    memcpy(r->prune_scratch, t->fitness, (size_t)t->size * sizeof(float));
+
+    // 2. Select the fitness of the last kept entry (O(n) expected)
+    uint32_t keep = (uint32_t)(t->size * r->fitness_params.prune_threshold);
+    if (keep < t->size) {
+        float cutoff = (keep > 0) ? select_kth_largest(r->prune_scratch, t->size, keep - 1)
+                                  : 2.0f;
+
+        float reset_activity = cached_activity(r, (R_Cell){0, 0, 0, 0});
+
+        // Entries tied with the cutoff fill the remaining quota in tape order
+        uint32_t ties_kept = keep;
+        for (uint32_t i = 0; i < t->size; i++) {
+            ties_kept -= t->fitness[i] > cutoff;
         }
-    }
 
-    // 3. Reset low-fitness entries based on adaptive threshold
-    uint32_t prune_threshold = (uint32_t)(L1_TAPE_SIZE * r->fitness_params.prune_threshold);
-    for (uint32_t i = prune_threshold; i < L1_TAPE_SIZE; i++) {
-        if (!r->tape[i].essential) {
-            r->tape[i].cell = (R_Cell){0, 0, 0, 0};
-            r->tape[i].fitness = 0.0f;
-            r->tape[i].last_used = 0;
+        // 3. Reset entries below the keep line
+        for (uint32_t i = 0; i < t->size; i++) {
+            if (t->fitness[i] > cutoff) continue;
+            if (t->fitness[i] == cutoff && ties_kept > 0) {
+                ties_kept--;
+                continue;
+            }
+            if (!tape_essential(t, i)) {
+                t->cells[i] = (R_Cell){0, 0, 0, 0};
+                t->fitness[i] = 0.0f;
+                t->activity[i] = reset_activity;
+                t->last_used[i] = 0;
+            }
         }
     }
 
@@ -266,37 +958,33 @@ void l2a_prune_tape(L2a_Runtime* r) {
 }
 
 Tape_Entry l2a_get_tape_entry(L2a_Runtime* r, uint32_t index) {
-    return r->tape[index % L1_TAPE_SIZE];
+    index &= r->tape.mask;
+    return (Tape_Entry){
+        .cell = r->tape.cells[index],
+        .fitness = r->tape.fitness[index],
+        .activity = r->tape.activity[index],
+        .last_used = r->tape.last_used[index],
+        .essential = tape_essential(&r->tape, index)
+    };
 }
 
 // Tape statistics for introspection and meta-evolution
 Tape_Stats l2a_get_tape_stats(L2a_Runtime* r) {
+    const Tape_Kernels* k = tape_kernels();
     Tape_Stats stats = {0};
     float fitness_sum = 0.0f;
     stats.min_fitness = 1.0f;
     stats.max_fitness = 0.0f;
 
-    for (uint32_t i = 0; i < L1_TAPE_SIZE; i++) {
-        Tape_Entry* entry = &r->tape[i];
+    k->fitness_stats(r->tape.fitness, r->tape.size,
+                     &stats.min_fitness, &stats.max_fitness, &fitness_sum);
+    stats.active_count = k->active_count(r->tape.cells, r->tape.size);
+    stats.essential_count = k->essential_count(r->tape.essential, r->tape.size / 64);
 
-        // Count active entries (non-zero gate)
-        if (entry->cell.gate != 0 || entry->cell.a != 0) {
-            stats.active_count++;
-        }
-
-        // Count essential entries
-        if (entry->essential) {
-            stats.essential_count++;
-        }
-
-        // Fitness statistics
-        fitness_sum += entry->fitness;
-        if (entry->fitness < stats.min_fitness) stats.min_fitness = entry->fitness;
-        if (entry->fitness > stats.max_fitness) stats.max_fitness = entry->fitness;
-    }
-
-    stats.avg_fitness = fitness_sum / L1_TAPE_SIZE;
+    stats.avg_fitness = fitness_sum / r->tape.size;
     stats.pruning_cycles = r->pruning_cycles;
+    stats.tape_size = r->tape.size;
+    stats.reads_avoided = r->reads_avoided;
 
     return stats;
 }
@@ -326,11 +1014,7 @@ void l2a_tune_fitness(L2a_Runtime* r, Fitness_Params params) {
     }
 
     // Recompute fitness for all entries with new parameters
-    for (uint32_t i = 0; i < L1_TAPE_SIZE; i++) {
-        if (!r->tape[i].essential) {
-            r->tape[i].fitness = l2a_compute_fitness(r, i);
-        }
-    }
+    l2a_compute_fitness_batch(r);
 }
 
 // ============================================================================
@@ -341,6 +1025,7 @@ L2b_Runtime* l2b_init(L2a_Runtime* l2a) {
     L2b_Runtime* r = malloc(sizeof(L2b_Runtime));
     if (!r) return NULL;
     r->l2a = l2a;
+    r->direct = false;
     return r;
 }
 
@@ -348,14 +1033,51 @@ void l2b_free(L2b_Runtime* r) {
     free(r);
 }
 
+bool l2b_set_direct(L2b_Runtime* r, bool enabled) {
+    Qubit_Backend_Type backend = r->l2a->qubit_state->backend_type;
+    if (enabled && backend != QUBIT_BACKEND_CLASSICAL && backend != QUBIT_BACKEND_PACKED) {
+        return false;  // No flat bit storage to overwrite
+    }
+    r->direct = enabled;
+    return true;
+}
+
+// Direct mode: result = op(a, b) as one store, recorded as one cell
+static void l2b_dissipate(L2b_Runtime* r, L2b_Op op, uint8_t a, uint8_t b, uint8_t result) {
+    L2a_Runtime* l2a = r->l2a;
+    Qubit_State* s = l2a->qubit_state;
+    uint8_t old;
+
+    cow_touch(l2a, result);
+    if (QUBIT_IS_CLASSICAL(s)) {
+        uint8_t* bits = QUBIT_CLASSICAL_BITS(s);
+        old = classical_bits_SET(bits, result, l2b_op_eval(op, bits[a], bits[b]));
+    } else {
+        uint64_t* words = QUBIT_PACKED_WORDS(s);
+        uint8_t value = l2b_op_eval(op, (uint8_t)packed_words_get(words, a),
+                                    (uint8_t)packed_words_get(words, b));
+        old = packed_words_SET(words, result, value);
+    }
+    mark_qubit_dirty(l2a, result);
+    record_to_tape(l2a, (R_Cell){(uint8_t)(L2A_GATE_DISSIPATIVE | op << 1 | old), a, b, result});
+}
+
 // Irreversible operations
 
 void l2b_AND(L2b_Runtime* r, uint8_t a, uint8_t b, uint8_t result) {
+    if (r->direct) {
+        l2b_dissipate(r, L2B_OP_AND, a, b, result);
+        return;
+    }
     if (qubit_read(r->l2a->qubit_state, result)) l2a_NOT(r->l2a, result);
     l2a_CCNOT(r->l2a, a, b, result);
 }
 
 void l2b_OR(L2b_Runtime* r, uint8_t a, uint8_t b, uint8_t result) {
+    if (r->direct) {
+        l2b_dissipate(r, L2B_OP_OR, a, b, result);
+        return;
+    }
     l2a_NOT(r->l2a, a);
     l2a_NOT(r->l2a, b);
     l2b_AND(r, a, b, result);
@@ -365,17 +1087,29 @@ void l2b_OR(L2b_Runtime* r, uint8_t a, uint8_t b, uint8_t result) {
 }
 
 void l2b_XOR(L2b_Runtime* r, uint8_t a, uint8_t b, uint8_t result) {
+    if (r->direct) {
+        l2b_dissipate(r, L2B_OP_XOR, a, b, result);
+        return;
+    }
     if (qubit_read(r->l2a->qubit_state, result)) l2a_NOT(r->l2a, result);
     l2a_CNOT(r->l2a, a, result);
     l2a_CNOT(r->l2a, b, result);
 }
 
 void l2b_NAND(L2b_Runtime* r, uint8_t a, uint8_t b, uint8_t result) {
+    if (r->direct) {
+        l2b_dissipate(r, L2B_OP_NAND, a, b, result);
+        return;
+    }
     l2b_AND(r, a, b, result);
     l2a_NOT(r->l2a, result);
 }
 
 void l2b_NOR(L2b_Runtime* r, uint8_t a, uint8_t b, uint8_t result) {
+    if (r->direct) {
+        l2b_dissipate(r, L2B_OP_NOR, a, b, result);
+        return;
+    }
     l2b_OR(r, a, b, result);
     l2a_NOT(r->l2a, result);
 }
@@ -679,7 +1413,7 @@ void moop_print_stats(Moop_Runtime* moop) {
     printf("=== Moop Runtime Statistics ===\n");
     printf("Instance ID: %u\n", moop->instance_id);
     printf("Qubits: %u\n", moop->l2a->qubit_count);
-    printf("Tape size: %d cells\n", L1_TAPE_SIZE);
+    printf("Tape size: %u cells\n", moop->l2a->tape.size);
     printf("Tape head: %u\n", moop->l2a->tape_head);
     printf("Total operations: %u\n", moop->l2a->total_ops);
     printf("Tape wrapped: %s\n", moop->l2a->tape_wrapped ? "Yes" : "No");
@@ -13,7 +13,15 @@
 // L1/L2a: Tape-Loop Turing Machine (Enhanced)
 // ============================================================================
 
-#define L1_TAPE_SIZE 1024  // From documentation: L1 limited to 1024 operations
+// Default tape capacity (from documentation: L1 limited to 1024 operations).
+// l2a_init_sized picks any power of two in [L2A_MIN_TAPE_SIZE, L2A_MAX_TAPE_SIZE]
+#ifndef L1_TAPE_SIZE
+#define L1_TAPE_SIZE 1024
+#endif
+#define L2A_MIN_TAPE_SIZE 64         // One essential-bitmap word
+#ifndef L2A_MAX_TAPE_SIZE
+#define L2A_MAX_TAPE_SIZE (1u << 24) // Growth cap (16M entries, 272 MB)
+#endif
 
 // R_Cell unchanged (4 bytes)
 typedef struct {
@@ -21,10 +29,47 @@ typedef struct {
     uint8_t a, b, c;
 } __attribute__((packed)) R_Cell;
 
-// Enhanced tape entry with evolutionary fitness (Enhancement 5)
+// Dissipative L2b ops (l2b_set_direct) take one cell: gate is
+// L2A_GATE_DISSIPATIVE | op << 1 | the result bit it overwrote, a and b
+// are the inputs and c the result. Replay recomputes c going forward and
+// puts the saved bit back going backward
+#define L2A_GATE_DISSIPATIVE 0x10
+
+typedef enum {
+    L2B_OP_AND,
+    L2B_OP_OR,
+    L2B_OP_XOR,
+    L2B_OP_NAND,
+    L2B_OP_NOR
+} L2b_Op;
+
+static inline bool l2a_is_dissipative(uint8_t gate) {
+    return (gate & 0xF0) == L2A_GATE_DISSIPATIVE && ((gate & 0x0F) >> 1) <= L2B_OP_NOR;
+}
+
+static inline uint8_t l2b_op_eval(uint8_t op, uint8_t x, uint8_t y) {
+    // Truth tables, one nibble per op indexed by x | y << 1
+    return (0x176E8u >> (op * 4 + (x | y << 1))) & 1;
+}
+
+// Structure-of-arrays tape (Enhancement 5): each field is a contiguous,
+// 64-byte aligned array in one allocation, so fitness scans touch only
+// fitness[] and replay touches only the 4 KB cells[]
+typedef struct {
+    R_Cell* cells;         // The operations
+    float* fitness;        // Evolutionary fitness (0.0-1.0)
+    float* activity;       // Cached qubit-activity component of fitness
+    uint32_t* last_used;   // Recency (for LRU component)
+    uint64_t* essential;   // Bitmap: marked essential (never prune)
+    uint32_t size;         // Capacity (power of two)
+    uint32_t mask;         // size - 1: slot = position & mask
+} L2a_Tape;
+
+// One tape slot gathered from the arrays (l2a_get_tape_entry)
 typedef struct {
     R_Cell cell;           // The operation
     float fitness;         // Evolutionary fitness (0.0-1.0)
+    float activity;        // Cached qubit-activity component of fitness
     uint32_t last_used;    // Recency (for LRU component)
     bool essential;        // Marked as essential (never prune)
 } Tape_Entry;
@@ -38,21 +83,77 @@ typedef struct {
     float prune_threshold;     // Fraction to keep (default 0.75)
 } Fitness_Params;
 
+// Copy of the qubit state after `position` ops (restore shortcut)
+typedef struct {
+    Qubit_State* state;
+    uint32_t position;
+    bool valid;
+} L2a_Snapshot;
+
+typedef struct L2a_Jit L2a_Jit;  // Native code cache (gate_jit.h)
+
+// Gate counts of a peephole pass (l2a_optimize)
+typedef struct {
+    uint64_t input_gates;
+    uint64_t output_gates;
+    uint64_t cancelled;        // Gates removed as self-inverse pairs (or SWAP a a)
+    uint64_t swaps_merged;     // SWAPs saved by rewriting chains as permutations
+} L2a_Opt_Stats;
+
 // Enhanced L2a Runtime: Tape-Loop with evolutionary pruning
 typedef struct {
     Qubit_State* qubit_state;  // Backend-agnostic qubit state (classical or quantum)
-    Tape_Entry* tape;          // Circular tape with fitness (1024 entries)
+    L2a_Tape tape;             // Circular tape with fitness (SoA)
     uint32_t tape_head;        // Current position (wraps)
     uint32_t qubit_count;
     uint32_t instance_id;
 
     // Tape-loop metadata
-    uint32_t total_ops;        // Total ops executed (can exceed 1024)
+    uint32_t total_ops;        // Total ops executed (can exceed tape size)
     bool tape_wrapped;         // Has tape wrapped around?
+    bool tape_growable;        // Double the tape instead of skipping essential slots
+    bool checkpoint_pending;   // Next recorded op is a checkpoint (pinned essential)
 
     // Evolutionary pruning metadata
     uint32_t pruning_cycles;   // Number of pruning cycles executed
     uint32_t last_prune_op;    // Operation count at last pruning
+    float* prune_scratch;      // Fitness copy for cutoff selection (one per entry)
+
+    // Incremental fitness: qubit values as of the last sync, plus the qubits
+    // gates have written since (cell operands are uint8_t, so 256 bits)
+    uint8_t* qubit_cache;
+    uint64_t qubit_dirty[4];
+
+    // Fast recording: metadata-only fitness on the gate path (no qubit reads)
+    bool fast_record;
+    uint64_t reads_avoided;    // qubit_read calls skipped by fast recording
+
+    // State snapshots: ring of snapshot_count copies, one every
+    // snapshot_interval ops and one per checkpoint
+    L2a_Snapshot* snapshots;
+    uint32_t snapshot_count;
+    uint32_t snapshot_interval;
+    uint32_t snapshot_next;    // Ring slot the next snapshot overwrites
+
+    // Copy-on-write checkpoint over flat bit storage (classical/packed):
+    // 8-byte words are saved on first write after l2a_checkpoint and
+    // copied back on restore
+    uint8_t* cow_saved;        // Checkpoint values of dirty words (NULL = off)
+    uint8_t* cow_live;         // Backend bit storage
+    uint32_t cow_bytes;
+    uint8_t cow_shift;         // Qubit -> byte offset (0 classical, 3 packed)
+    bool cow_active;           // Checkpoint at cow_position is restorable
+    uint32_t cow_position;
+    uint64_t cow_dirty;        // Words written since the checkpoint
+
+    // Compiled gate sequences (NULL = JIT off)
+    L2a_Jit* jit;
+
+    // Peephole pass before batch execution and JIT compilation
+    bool optimize;
+    R_Cell* opt_scratch;       // Optimized copy of the current sequence
+    uint32_t opt_capacity;
+    L2a_Opt_Stats opt_stats;   // Accumulated over every optimized sequence
 
     // Meta-evolution parameters (adaptive fitness tuning)
     Fitness_Params fitness_params;
@@ -60,6 +161,12 @@ typedef struct {
 
 // L2a API (quantum-ready)
 L2a_Runtime* l2a_init(uint32_t qubits, uint32_t instance_id, Qubit_Backend_Type backend);
+
+// Tape capacity chosen at init (rounded up to a power of two). A growable
+// tape doubles, up to L2A_MAX_TAPE_SIZE, whenever an essential entry would
+// otherwise block recording, so checkpointed history is never dropped
+L2a_Runtime* l2a_init_sized(uint32_t qubits, uint32_t instance_id, Qubit_Backend_Type backend,
+                            uint32_t tape_size, bool growable);
 void l2a_free(L2a_Runtime* r);
 
 void l2a_CCNOT(L2a_Runtime* r, uint8_t a, uint8_t b, uint8_t c);
@@ -67,11 +174,116 @@ void l2a_CNOT(L2a_Runtime* r, uint8_t a, uint8_t b);
 void l2a_NOT(L2a_Runtime* r, uint8_t a);
 void l2a_SWAP(L2a_Runtime* r, uint8_t a, uint8_t b);
 
+// Run a gate sequence with one backend dispatch and record the cells as
+// given, bulk-copied into free slots. Fitness sees the state after the
+// whole batch; the snapshot and prune triggers are checked once at the end
+void l2a_execute_batch(L2a_Runtime* r, const R_Cell* cells, uint32_t n);
+
+// Checkpoints are logical op positions, stable across tape growth; restore
+// can rewind at most one tape length
 uint32_t l2a_checkpoint(L2a_Runtime* r);
 void l2a_restore(L2a_Runtime* r, uint32_t checkpoint);
 
+// Keep `count` state copies, taken every `interval` ops and at each
+// checkpoint; restore then loads the nearest copy and replays only the
+// ops in between. Memory is count x backend state size (2^n amplitudes
+// on the simulator). count == 0 disables snapshots. Returns false if the
+// copies cannot be allocated (snapshots stay disabled)
+bool l2a_set_snapshots(L2a_Runtime* r, uint32_t interval, uint32_t count);
+
+// Copy-on-write checkpoints: l2a_checkpoint just clears a dirty mask and
+// restoring to the latest checkpoint copies back only the words written
+// since, with no gate replay. Older checkpoints fall back to snapshots or
+// rewinding. Needs the classical or packed backend (returns false
+// otherwise); gates must go through l2a_* while enabled
+bool l2a_set_cow_checkpoints(L2a_Runtime* r, bool enabled);
+
 const char* l2a_print(R_Cell cell);
 
+// ============================================================================
+// Peephole Optimizer
+// ============================================================================
+
+// Rewrite cells in place and return the new length: identical self-inverse
+// gates cancel when every gate between them commutes with them (none
+// writes a qubit the other touches), SWAP a a is dropped, and runs of
+// SWAPs become the fewest SWAPs with the same permutation. One linear
+// pass; kept cells come back with canonical operands. Cells with
+// gate > 3 are kept and act as barriers. stats may be NULL
+uint32_t l2a_optimize(R_Cell* cells, uint32_t n, L2a_Opt_Stats* stats);
+
+// Run l2a_optimize on every l2a_execute_batch and on each sequence the
+// JIT compiles (cache keys stay the original cells). Batches then record
+// the optimized cells. Counts accumulate in r->opt_stats. The pass costs
+// about as much per gate as running one, so it pays off for compiled or
+// stored sequences more than for one-shot batches
+void l2a_set_optimize(L2a_Runtime* r, bool enabled);
+
+// Internal (batches and the JIT): the optimized copy of cells in the
+// runtime's scratch buffer (updating *n), or cells itself when optimization
+// is off. Valid until the next call
+const R_Cell* l2a_optimize_cells(L2a_Runtime* r, const R_Cell* cells, uint32_t* n);
+
+// ============================================================================
+// Stored Programs (threaded-code interpreter)
+// ============================================================================
+
+// One pre-decoded gate (8 bytes): the backend-specific handler, as an
+// offset into the interpreter, plus its qubit operands
+typedef struct {
+    int32_t handler;
+    uint8_t a, b, c;
+    uint8_t op;                // L2b_Op of a dissipative cell
+} L2a_Instr;
+
+// Gate sequence compiled for one backend type
+typedef struct {
+    L2a_Instr* code;           // length instructions, then an end marker
+    uint32_t length;
+    Qubit_Backend_Type backend;
+    uint64_t written[4];       // Qubits the program writes
+} L2a_Program;
+
+// Decode cells once (dissipative cells run forward, other cells with
+// gate > 3 are dropped); NULL on allocation failure
+L2a_Program* l2a_program_compile(const R_Cell* cells, uint32_t n, Qubit_Backend_Type backend);
+
+// Program of the recorded ops at logical positions [from, to), clamped to
+// the history still on the tape
+L2a_Program* l2a_program_from_tape(const L2a_Runtime* r, uint32_t from, uint32_t to);
+
+// Execute forward on any state of the program's backend type (false on a
+// mismatch). Nothing is recorded
+bool l2a_program_run(const L2a_Program* p, Qubit_State* state);
+
+// Run on the runtime's own state without recording, keeping the activity
+// cache and copy-on-write checkpoint coherent
+bool l2a_run_program(L2a_Runtime* r, const L2a_Program* p);
+
+// Internal (programs and the JIT): account for qubits written outside the
+// l2a_* gates (activity cache and copy-on-write)
+void l2a_touch_written(L2a_Runtime* r, const uint64_t written[4]);
+
+void l2a_program_free(L2a_Program* p);
+
+// ============================================================================
+// Native Code (gate-sequence JIT)
+// ============================================================================
+
+// Cache up to `capacity` compiled sequences, keyed by content hash. On
+// x86-64 packed-backend sequences become straight-line machine code;
+// other targets and backends cache a threaded program. 0 disables
+bool l2a_set_jit(L2a_Runtime* r, uint32_t capacity);
+
+// Run cells on the runtime's state, compiling on first use. Like
+// l2a_run_program: not recorded, activity and copy-on-write kept coherent.
+// False if the JIT is off or a compile fails
+bool l2a_jit_run(L2a_Runtime* r, const R_Cell* cells, uint32_t n);
+
+// Same for the recorded ops at logical positions [from, to).
+// l2a_write_tape and l2a_meta_modify drop the entries covering a slot
+bool l2a_jit_run_tape(L2a_Runtime* r, uint32_t from, uint32_t to);
+
 // ============================================================================
 // Self-Modification API (NEW)
 // ============================================================================
@@ -92,12 +304,21 @@ void l2a_meta_modify(L2a_Runtime* r, R_Cell* modification_rule, uint32_t rule_le
 // Compute fitness for a tape entry based on current execution state
 float l2a_compute_fitness(L2a_Runtime* r, uint32_t index);
 
+// Recompute fitness for every non-essential entry in one vectorized pass
+// (reads back only qubits changed since the last pass)
+void l2a_compute_fitness_batch(L2a_Runtime* r);
+
 // Mark operation as essential (never prune, e.g., checkpoints)
 void l2a_mark_essential(L2a_Runtime* r, uint32_t index);
 
 // Perform evolutionary pruning cycle (selective retention)
 void l2a_prune_tape(L2a_Runtime* r);
 
+// Fast recording: score new entries by gate type and recency only, deferring
+// the qubit-activity term to the next prune (avoids reads that would
+// collapse a simulator state)
+void l2a_set_fast_record(L2a_Runtime* r, bool enabled);
+
 // Get tape entry with fitness metadata
 Tape_Entry l2a_get_tape_entry(L2a_Runtime* r, uint32_t index);
 
@@ -109,6 +330,8 @@ typedef struct {
     uint32_t essential_count;  // Number of essential entries
     uint32_t active_count;     // Number of non-zero entries
     uint32_t pruning_cycles;   // Total pruning cycles executed
+    uint64_t reads_avoided;    // qubit_read calls skipped by fast recording
+    uint32_t tape_size;        // Current capacity
 } Tape_Stats;
 
 Tape_Stats l2a_get_tape_stats(L2a_Runtime* r);
@@ -141,6 +364,7 @@ typedef struct {
 
 typedef struct {
     L2a_Runtime* l2a;
+    bool direct;               // One dissipative op per call (l2b_set_direct)
 } L2b_Runtime;
 
 // L2b API
@@ -154,6 +378,74 @@ void l2b_XOR(L2b_Runtime* r, uint8_t a, uint8_t b, uint8_t result);
 void l2b_NAND(L2b_Runtime* r, uint8_t a, uint8_t b, uint8_t result);
 void l2b_NOR(L2b_Runtime* r, uint8_t a, uint8_t b, uint8_t result);
 
+// Direct mode: each op above overwrites result in one step and records a
+// single dissipative cell (holding the old result bit for undo) instead of
+// its reversible expansion. Needs the classical or packed backend (returns
+// false otherwise)
+bool l2b_set_direct(L2b_Runtime* r, bool enabled);
+
+// ============================================================================
+// L2b Circuits (build once, evaluate many times)
+// ============================================================================
+
+// A wire is the index of the node driving it
+typedef uint32_t L2b_Wire;
+
+#define L2B_NODE_INPUT 0xFF    // Node op: reads a qubit instead of computing
+
+typedef struct {
+    uint8_t op;                // L2b_Op, or L2B_NODE_INPUT
+    uint8_t qubit;             // Input nodes: the qubit read
+    L2b_Wire x, y;             // Gate nodes: operands (earlier wires)
+} L2b_Node;
+
+typedef struct {
+    L2b_Wire wire;
+    uint8_t qubit;
+} L2b_Output;
+
+// DAG of irreversible ops. l2b_circuit_compile schedules it depth-first
+// from the outputs (dropping nodes no output needs), gives each
+// intermediate value an ancilla qubit that is reused once the value is
+// dead, and lowers the schedule to dissipative cells
+typedef struct {
+    L2b_Node* nodes;
+    uint32_t node_count;
+    uint32_t node_capacity;
+    L2b_Output* outputs;
+    uint32_t output_count;
+    uint32_t output_capacity;
+
+    R_Cell* cells;             // Compiled schedule (NULL until compiled)
+    uint32_t cell_count;
+    uint32_t ancillas_used;    // Distinct ancilla qubits the schedule needs
+    L2a_Program* program;      // Threaded form for the last backend run
+} L2b_Circuit;
+
+L2b_Circuit* l2b_circuit_create(void);
+void l2b_circuit_free(L2b_Circuit* c);
+
+// Builders; gates and outputs only take wires created before them.
+// Return UINT32_MAX on allocation failure or a bad operand
+L2b_Wire l2b_circuit_input(L2b_Circuit* c, uint8_t qubit);
+L2b_Wire l2b_circuit_gate(L2b_Circuit* c, L2b_Op op, L2b_Wire x, L2b_Wire y);
+bool l2b_circuit_output(L2b_Circuit* c, L2b_Wire w, uint8_t qubit);
+
+// Schedule and allocate intermediates to qubits [first_ancilla,
+// first_ancilla + ancilla_count), which must not overlap the circuit's
+// inputs or outputs. Outputs are written only after every input read
+// that could see them. False if the ancillas do not suffice or overlap
+bool l2b_circuit_compile(L2b_Circuit* c, uint8_t first_ancilla, uint32_t ancilla_count);
+
+// One evaluation on any classical or packed state: outputs are
+// overwritten, ancillas left holding scratch values. Nothing is recorded
+bool l2b_circuit_eval(L2b_Circuit* c, Qubit_State* state);
+
+// Same on the runtime's state, keeping the activity cache and
+// copy-on-write checkpoint coherent; runs native code when the L2a JIT
+// is on and can compile the circuit, the threaded program otherwise
+bool l2b_circuit_run(L2b_Runtime* r, L2b_Circuit* c);
+
 // Enhanced MAYBE API (NEW)
 L2b_Maybe l2b_maybe_create(const char* condition_name);
 void l2b_maybe_resolve(L2b_Maybe* m, bool value, float confidence, const char* reasoning);
@@ -16,15 +16,43 @@
 typedef enum {
     QUBIT_BACKEND_CLASSICAL,    // Default: Classical bits (uint8_t)
     QUBIT_BACKEND_SIMULATOR,    // Future: Quantum simulator (statevector)
-    QUBIT_BACKEND_QUANTUM       // Future: Real quantum hardware
+    QUBIT_BACKEND_QUANTUM,      // Future: Real quantum hardware
+    QUBIT_BACKEND_PACKED,       // Classical bits packed 64 per uint64_t word
+    QUBIT_BACKEND_BITSLICED,    // BITSLICE_LANES independent classical instances
+    QUBIT_BACKEND_SPARSE        // Quantum simulator storing only nonzero amplitudes
 } Qubit_Backend_Type;
 
+// ============================================================================
+// Fixed-Backend Build Mode
+// ============================================================================
+// -DMOOP_FIXED_BACKEND_CLASSICAL or -DMOOP_FIXED_BACKEND_PACKED hard-wires
+// every Qubit_State to one classical backend: qubit_* and everything built
+// on them (L2a gates, tape fitness) compile to the bare bit kernel with no
+// indirect call, and the registry links no other backend.
+
+#if defined(MOOP_FIXED_BACKEND_CLASSICAL) && defined(MOOP_FIXED_BACKEND_PACKED)
+#error "Define at most one MOOP_FIXED_BACKEND_* option"
+#endif
+
+#if defined(MOOP_FIXED_BACKEND_CLASSICAL)
+#define MOOP_FIXED_BACKEND QUBIT_BACKEND_CLASSICAL
+#elif defined(MOOP_FIXED_BACKEND_PACKED)
+#define MOOP_FIXED_BACKEND QUBIT_BACKEND_PACKED
+#endif
+
+#if defined(MOOP_FIXED_BACKEND) && defined(ENABLE_QUANTUM_SIMULATOR)
+#error "MOOP_FIXED_BACKEND_* cannot be combined with ENABLE_QUANTUM_SIMULATOR"
+#endif
+
 // ============================================================================
 // Abstract Qubit State
 // ============================================================================
 
+typedef struct Qubit_Backend_Ops Qubit_Backend_Ops;
+
 typedef struct Qubit_State {
     Qubit_Backend_Type backend_type;
+    const Qubit_Backend_Ops* ops;   // Resolved once by the backend's init
     void* backend_data;         // Opaque pointer to implementation
     uint32_t qubit_count;
 
@@ -36,11 +64,13 @@ typedef struct Qubit_State {
 // Backend Operations (Virtual Function Table)
 // ============================================================================
 
-typedef struct {
+struct Qubit_Backend_Ops {
     // Lifecycle
     Qubit_State* (*init)(uint32_t n_qubits);
     void (*free)(Qubit_State* state);
     Qubit_State* (*clone)(const Qubit_State* state);
+    // Overwrite dst with src (same backend and qubit count, no allocation)
+    void (*copy)(Qubit_State* dst, const Qubit_State* src);
 
     // Reversible gates (quantum-compatible)
     void (*CCNOT)(Qubit_State* state, uint8_t a, uint8_t b, uint8_t c);
@@ -54,10 +84,13 @@ typedef struct {
     // Read state (for classical: direct read, for quantum: measure without collapse if possible)
     uint8_t (*read)(const Qubit_State* state, uint8_t qubit);
 
+    // Probability that measuring the qubit gives 1, without collapsing
+    double (*probability)(const Qubit_State* state, uint8_t qubit);
+
     // Backend info
     const char* (*name)(void);
     bool (*is_quantum)(void);
-} Qubit_Backend_Ops;
+};
 
 // ============================================================================
 // Backend Registry
@@ -80,22 +113,248 @@ typedef struct {
 // Classical backend operations
 extern const Qubit_Backend_Ops classical_backend_ops;
 
+// ============================================================================
+// Bit-Packed Classical Backend
+// ============================================================================
+// Qubit q lives in bit (q & 63) of words[q >> 6]; gates are branch-free
+// mask/shift kernels. Bits at or above qubit_count are always zero.
+
+typedef struct {
+    uint64_t* words;            // Packed classical bits
+    uint32_t word_count;        // ceil(qubit_count / 64)
+} Packed_Qubit_State;
+
+extern const Qubit_Backend_Ops packed_backend_ops;
+
+// ============================================================================
+// Inline Gate Kernels (shared by the backends and the qubit_* fast path)
+// ============================================================================
+
+static inline void classical_bits_CCNOT(uint8_t* bits, uint8_t a, uint8_t b, uint8_t c) {
+    bits[c] ^= bits[a] & bits[b];
+}
+
+static inline void classical_bits_CNOT(uint8_t* bits, uint8_t a, uint8_t b) {
+    bits[b] ^= bits[a];
+}
+
+static inline void classical_bits_NOT(uint8_t* bits, uint8_t a) {
+    bits[a] ^= 1;
+}
+
+static inline void classical_bits_SWAP(uint8_t* bits, uint8_t a, uint8_t b) {
+    uint8_t temp = bits[a];
+    bits[a] = bits[b];
+    bits[b] = temp;
+}
+
+// Irreversible overwrite (L2b direct mode); returns the previous bit
+static inline uint8_t classical_bits_SET(uint8_t* bits, uint8_t q, uint8_t value) {
+    uint8_t old = bits[q];
+    bits[q] = value;
+    return old;
+}
+
+static inline uint64_t packed_words_get(const uint64_t* words, uint8_t q) {
+    return (words[q >> 6] >> (q & 63)) & 1;
+}
+
+static inline void packed_words_flip(uint64_t* words, uint8_t q, uint64_t bit) {
+    words[q >> 6] ^= bit << (q & 63);
+}
+
+static inline void packed_words_CCNOT(uint64_t* words, uint8_t a, uint8_t b, uint8_t c) {
+    packed_words_flip(words, c, packed_words_get(words, a) & packed_words_get(words, b));
+}
+
+static inline void packed_words_CNOT(uint64_t* words, uint8_t a, uint8_t b) {
+    packed_words_flip(words, b, packed_words_get(words, a));
+}
+
+static inline void packed_words_NOT(uint64_t* words, uint8_t a) {
+    packed_words_flip(words, a, 1);
+}
+
+static inline void packed_words_SWAP(uint64_t* words, uint8_t a, uint8_t b) {
+    // Flip both bits iff they differ
+    uint64_t diff = packed_words_get(words, a) ^ packed_words_get(words, b);
+    packed_words_flip(words, a, diff);
+    packed_words_flip(words, b, diff);
+}
+
+static inline uint8_t packed_words_SET(uint64_t* words, uint8_t q, uint8_t value) {
+    uint64_t old = packed_words_get(words, q);
+    packed_words_flip(words, q, old ^ value);
+    return (uint8_t)old;
+}
+
+// Bulk operations on whole words (masks hold word_count words)
+// NOT every qubit set in mask
+void qubit_packed_NOT_mask(Qubit_State* state, const uint64_t* mask);
+// CNOT each control qubit q in control_mask onto target q + offset.
+// All controls are sampled before any target flips.
+void qubit_packed_CNOT_mask(Qubit_State* state, const uint64_t* control_mask, uint32_t offset);
+
+// ============================================================================
+// Bit-Sliced Multi-Instance Backend
+// ============================================================================
+// Each qubit is a slice of BITSLICE_WORDS words; bit k of the slice belongs
+// to instance (lane) k, so one gate evaluates every lane at once.
+// Build with -DMOOP_BITSLICE_WIDTH=256 (and -mavx2) for 256 lanes.
+// read/measure report lane 0; use the lane API for the others.
+
+#ifndef MOOP_BITSLICE_WIDTH
+#define MOOP_BITSLICE_WIDTH 64
+#endif
+
+#if MOOP_BITSLICE_WIDTH % 64 != 0
+#error "MOOP_BITSLICE_WIDTH must be a multiple of 64"
+#endif
+
+#define BITSLICE_LANES MOOP_BITSLICE_WIDTH
+#define BITSLICE_WORDS (MOOP_BITSLICE_WIDTH / 64)
+
+typedef struct {
+    uint64_t* slices;           // Qubit q: slices[q * BITSLICE_WORDS ...]
+} Bitsliced_Qubit_State;
+
+extern const Qubit_Backend_Ops bitsliced_backend_ops;
+
+// Per-lane access
+void qubit_bitsliced_set_lane(Qubit_State* state, uint32_t lane, uint8_t qubit, uint8_t value);
+uint8_t qubit_bitsliced_get_lane(const Qubit_State* state, uint32_t lane, uint8_t qubit);
+
+// Whole-slice access (BITSLICE_WORDS words, bit k = lane k)
+void qubit_bitsliced_load(Qubit_State* state, uint8_t qubit, const uint64_t* lanes);
+void qubit_bitsliced_store(const Qubit_State* state, uint8_t qubit, uint64_t* lanes);
+
 // ============================================================================
 // Quantum Simulator Backend (Optional - compile with -DENABLE_QUANTUM_SIMULATOR)
 // ============================================================================
 
 #ifdef ENABLE_QUANTUM_SIMULATOR
 
+// Gate fusion: every gate permutes basis states, so consecutive gates are
+// queued and a run touching at most SIM_FUSE_QUBITS distinct qubits is
+// applied as one composed permutation in a single sweep. The queue is
+// flushed before anything observes the amplitudes (measure, read, copy).
+#define SIM_FUSE_GATES 64
+#define SIM_FUSE_QUBITS 8
+
+// Sweeps over large states are split across a shared worker pool
+#define SIM_MAX_THREADS 64
+
+typedef struct {
+    uint8_t gate;               // 0 CCNOT, 1 CNOT, 2 NOT, 3 SWAP
+    uint8_t a, b, c;
+} Sim_Gate;
+
+// Amplitude storage. Split keeps real and imaginary parts in two arrays;
+// interleaved stores {re, im} pairs, so a swapped amplitude is one 16-byte
+// unit in one stream. Buffers are 64-byte aligned, and from 2 MiB up they
+// are mapped directly and advised onto transparent huge pages.
+typedef enum {
+    SIM_LAYOUT_SPLIT,           // Default
+    SIM_LAYOUT_INTERLEAVED
+} Sim_Layout;
+
 typedef struct {
     // State vector: 2^n complex amplitudes
     // For n qubits: |ψ⟩ = Σ αᵢ|i⟩ where i ∈ {0,1}^n
-    double* real_amplitudes;    // Real parts
-    double* imag_amplitudes;    // Imaginary parts
+    Sim_Layout layout;
+    double* real_amplitudes;    // Split: real parts (NULL when interleaved)
+    double* imag_amplitudes;    // Split: imaginary parts (NULL when interleaved)
+    double* amplitudes;         // Interleaved: re, im of index i at [2i], [2i + 1]
     uint64_t state_size;        // 2^n
+
+    bool fusion;                // Queue gates (default on)
+    uint32_t pending_count;
+    uint64_t pending_mask;      // Qubits the queued gates touch
+    Sim_Gate pending[SIM_FUSE_GATES];
+    uint64_t sweeps;            // Passes over the statevector so far
+    uint32_t threads;           // Threads per sweep (default 1)
+
+    // Probability cache, describing the logical state (queued gates included)
+    double marginals[64];       // Σ|αᵢ|² over the indices with qubit q set
+    double marginal_total;      // Σ|αᵢ|² the marginals were taken against
+    uint64_t marginal_valid;    // Qubits whose marginal is current
+    double* block_cumulative;   // Σ|αᵢ|² up to the end of each 256-amplitude block
+    bool blocks_valid;
 } Quantum_Simulator_State;
 
 extern const Qubit_Backend_Ops quantum_simulator_ops;
 
+// Apply any queued gates and drop the probability cache (call before
+// touching the amplitudes directly)
+void quantum_simulator_flush(Qubit_State* state);
+
+// Turn fusion on or off; turning it off flushes the queue
+void quantum_simulator_set_fusion(Qubit_State* state, bool enabled);
+
+// Convert the state to another amplitude layout (reallocates); false if
+// the new buffers cannot be allocated, leaving the state as it was
+bool quantum_simulator_set_layout(Qubit_State* state, Sim_Layout layout);
+
+// Layout-independent amplitude access (queued gates are applied first)
+void quantum_simulator_get_amplitude(Qubit_State* state, uint64_t index, double* re, double* im);
+void quantum_simulator_set_amplitude(Qubit_State* state, uint64_t index, double re, double im);
+
+// Measure several qubits in one pass per group of up to 10 (one
+// probability sweep and one collapse sweep each); outcomes[i] receives
+// the result for qubits[i]
+void quantum_simulator_measure_qubits(Qubit_State* state, const uint8_t* qubits, uint32_t count,
+                                      uint8_t* outcomes);
+
+// Non-collapsing queries. One sweep caches every qubit's marginal and a
+// cumulative probability table; NOT and SWAP update the marginals in
+// place, CNOT and CCNOT too when their controls are certain (otherwise
+// they invalidate only their target), and a measurement leaves the
+// measured qubits known. qubit_read reports the more likely
+// outcome (ties read 0) and qubit_probability the exact marginal.
+
+// Draw shots from the joint distribution of count ≤ 64 qubits without
+// touching the state: bit i of results[s] is qubits[i] in shot s. One
+// sweep at most, none while the table is current; false if the table
+// cannot be allocated
+bool quantum_simulator_sample(Qubit_State* state, const uint8_t* qubits, uint32_t count,
+                              uint32_t shots, uint64_t* results);
+
+// Threads used by this state's gate, measure and normalize sweeps,
+// clamped to [1, SIM_MAX_THREADS]; clones inherit it
+void quantum_simulator_set_threads(Qubit_State* state, uint32_t threads);
+
+// ============================================================================
+// Sparse Simulator Backend (built with the statevector simulator)
+// ============================================================================
+// Keeps only the nonzero amplitudes as (basis index, amplitude) entries.
+// Every gate permutes basis states, so it rewrites the stored indices in
+// place and never adds a term: memory and gate cost follow the number of
+// terms, not 2^n, and registers of up to 64 qubits are practical while
+// the state stays close to a few basis states.
+
+#define SPARSE_MAX_QUBITS 64
+
+typedef struct {
+    uint64_t* indices;          // Basis state of each entry
+    double* real;               // Its amplitude
+    double* imag;
+    uint32_t count;             // Entries in use (all nonzero)
+    uint32_t capacity;
+    uint32_t* slots;            // Index lookup, open addressed: entry + 1, 0 = empty
+    uint32_t slot_bits;         // 2^slot_bits slots
+    bool slots_valid;           // Gates move indices; the next lookup rebuilds
+} Sparse_Qubit_State;
+
+extern const Qubit_Backend_Ops sparse_simulator_ops;
+
+// Amplitude of a basis state (0 when not stored). Setting 0 drops the
+// entry; false if a new entry cannot be allocated
+void sparse_simulator_get_amplitude(Qubit_State* state, uint64_t index, double* re, double* im);
+bool sparse_simulator_set_amplitude(Qubit_State* state, uint64_t index, double re, double im);
+
+// Number of nonzero amplitudes stored
+uint32_t sparse_simulator_count(const Qubit_State* state);
+
 #endif
 
 // ============================================================================
@@ -127,15 +386,98 @@ void qubit_free(Qubit_State* state);
 // Clone qubit state (deep copy)
 Qubit_State* qubit_clone(const Qubit_State* state);
 
+// Copy src into an existing state of the same backend and size, reusing
+// dst's buffers; returns false if the states are not compatible
+bool qubit_copy(Qubit_State* dst, const Qubit_State* src);
+
 // Apply gates (backend-agnostic)
-void qubit_CCNOT(Qubit_State* state, uint8_t a, uint8_t b, uint8_t c);
-void qubit_CNOT(Qubit_State* state, uint8_t a, uint8_t b);
-void qubit_NOT(Qubit_State* state, uint8_t a);
-void qubit_SWAP(Qubit_State* state, uint8_t a, uint8_t b);
+// Inline: the classical backends run their kernel directly, everything else
+// makes one indirect call through the ops table cached in the state.
+
+#define QUBIT_CLASSICAL_BITS(state) (((Classical_Qubit_State*)(state)->backend_data)->bits)
+#define QUBIT_PACKED_WORDS(state) (((Packed_Qubit_State*)(state)->backend_data)->words)
+
+// Backend tests fold to constants in fixed-backend builds
+#ifdef MOOP_FIXED_BACKEND
+#define QUBIT_IS_CLASSICAL(state) (MOOP_FIXED_BACKEND == QUBIT_BACKEND_CLASSICAL)
+#define QUBIT_IS_PACKED(state) (MOOP_FIXED_BACKEND == QUBIT_BACKEND_PACKED)
+#else
+#define QUBIT_IS_CLASSICAL(state) ((state)->backend_type == QUBIT_BACKEND_CLASSICAL)
+#define QUBIT_IS_PACKED(state) ((state)->backend_type == QUBIT_BACKEND_PACKED)
+#endif
+
+static inline void qubit_CCNOT(Qubit_State* state, uint8_t a, uint8_t b, uint8_t c) {
+    if (!state) return;
+    if (QUBIT_IS_CLASSICAL(state)) {
+        classical_bits_CCNOT(QUBIT_CLASSICAL_BITS(state), a, b, c);
+    } else if (QUBIT_IS_PACKED(state)) {
+        packed_words_CCNOT(QUBIT_PACKED_WORDS(state), a, b, c);
+    } else {
+        state->ops->CCNOT(state, a, b, c);
+    }
+}
+
+static inline void qubit_CNOT(Qubit_State* state, uint8_t a, uint8_t b) {
+    if (!state) return;
+    if (QUBIT_IS_CLASSICAL(state)) {
+        classical_bits_CNOT(QUBIT_CLASSICAL_BITS(state), a, b);
+    } else if (QUBIT_IS_PACKED(state)) {
+        packed_words_CNOT(QUBIT_PACKED_WORDS(state), a, b);
+    } else {
+        state->ops->CNOT(state, a, b);
+    }
+}
+
+static inline void qubit_NOT(Qubit_State* state, uint8_t a) {
+    if (!state) return;
+    if (QUBIT_IS_CLASSICAL(state)) {
+        classical_bits_NOT(QUBIT_CLASSICAL_BITS(state), a);
+    } else if (QUBIT_IS_PACKED(state)) {
+        packed_words_NOT(QUBIT_PACKED_WORDS(state), a);
+    } else {
+        state->ops->NOT(state, a);
+    }
+}
+
+static inline void qubit_SWAP(Qubit_State* state, uint8_t a, uint8_t b) {
+    if (!state) return;
+    if (QUBIT_IS_CLASSICAL(state)) {
+        classical_bits_SWAP(QUBIT_CLASSICAL_BITS(state), a, b);
+    } else if (QUBIT_IS_PACKED(state)) {
+        packed_words_SWAP(QUBIT_PACKED_WORDS(state), a, b);
+    } else {
+        state->ops->SWAP(state, a, b);
+    }
+}
 
 // Measurement
-uint8_t qubit_measure(Qubit_State* state, uint8_t qubit);
-uint8_t qubit_read(const Qubit_State* state, uint8_t qubit);
+static inline uint8_t qubit_measure(Qubit_State* state, uint8_t qubit) {
+    if (!state) return 0;
+    return state->ops->measure(state, qubit);
+}
+
+static inline uint8_t qubit_read(const Qubit_State* state, uint8_t qubit) {
+    if (!state) return 0;
+    if (QUBIT_IS_CLASSICAL(state)) {
+        return QUBIT_CLASSICAL_BITS(state)[qubit];
+    }
+    if (QUBIT_IS_PACKED(state)) {
+        return (uint8_t)packed_words_get(QUBIT_PACKED_WORDS(state), qubit);
+    }
+    return state->ops->read(state, qubit);
+}
+
+// Probability of reading 1 without collapsing (0 or 1 on classical backends)
+static inline double qubit_probability(const Qubit_State* state, uint8_t qubit) {
+    if (!state) return 0.0;
+    if (QUBIT_IS_CLASSICAL(state)) {
+        return QUBIT_CLASSICAL_BITS(state)[qubit];
+    }
+    if (QUBIT_IS_PACKED(state)) {
+        return (double)packed_words_get(QUBIT_PACKED_WORDS(state), qubit);
+    }
+    return state->ops->probability(state, qubit);
+}
 
 // Backend info
 const char* qubit_backend_name(const Qubit_State* state);
@@ -0,0 +1,189 @@
+// packed_backend.c
+// Bit-packed classical qubit backend (64 qubits per uint64_t word)
+// Same semantics as the classical backend with 1/8th the memory and
+// branch-free gate kernels
+
+#define _POSIX_C_SOURCE 200809L
+#include "moop_quantum_ready.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Bit Helpers
+// ============================================================================
+
+// Mask of valid bits in the last word (bits >= qubit_count stay zero)
+static inline uint64_t packed_tail_mask(uint32_t n_qubits) {
+    uint32_t rem = n_qubits & 63;
+    return rem ? ((1ULL << rem) - 1) : ~0ULL;
+}
+
+// ============================================================================
+// Packed Backend Implementation
+// ============================================================================
+
+static Qubit_State* packed_init(uint32_t n_qubits) {
+    Qubit_State* state = malloc(sizeof(Qubit_State));
+    if (!state) return NULL;
+
+    state->backend_type = QUBIT_BACKEND_PACKED;
+    state->ops = &packed_backend_ops;
+    state->qubit_count = n_qubits;
+    state->metadata = NULL;
+
+    Packed_Qubit_State* packed = malloc(sizeof(Packed_Qubit_State));
+    if (!packed) {
+        free(state);
+        return NULL;
+    }
+
+    packed->word_count = (n_qubits + 63) / 64;
+    packed->words = calloc(packed->word_count ? packed->word_count : 1,
+                           sizeof(uint64_t));
+    if (!packed->words) {
+        free(packed);
+        free(state);
+        return NULL;
+    }
+
+    state->backend_data = packed;
+    return state;
+}
+
+static void packed_free(Qubit_State* state) {
+    if (!state) return;
+
+    Packed_Qubit_State* packed = (Packed_Qubit_State*)state->backend_data;
+
+    if (packed) {
+        free(packed->words);
+        free(packed);
+    }
+
+    free(state);
+}
+
+static void packed_copy(Qubit_State* dst, const Qubit_State* src) {
+    const Packed_Qubit_State* from = (const Packed_Qubit_State*)src->backend_data;
+    memcpy(QUBIT_PACKED_WORDS(dst), from->words, from->word_count * sizeof(uint64_t));
+}
+
+static Qubit_State* packed_clone(const Qubit_State* state) {
+    if (!state) return NULL;
+
+    Qubit_State* cloned = packed_init(state->qubit_count);
+    if (!cloned) return NULL;
+
+    packed_copy(cloned, state);
+
+    return cloned;
+}
+
+// ============================================================================
+// Branch-Free Reversible Gates
+// ============================================================================
+
+// Kernels live in moop_quantum_ready.h so qubit_* can inline them
+
+static void packed_CCNOT(Qubit_State* state, uint8_t a, uint8_t b, uint8_t c) {
+    packed_words_CCNOT(QUBIT_PACKED_WORDS(state), a, b, c);
+}
+
+static void packed_CNOT(Qubit_State* state, uint8_t a, uint8_t b) {
+    packed_words_CNOT(QUBIT_PACKED_WORDS(state), a, b);
+}
+
+static void packed_NOT(Qubit_State* state, uint8_t a) {
+    packed_words_NOT(QUBIT_PACKED_WORDS(state), a);
+}
+
+static void packed_SWAP(Qubit_State* state, uint8_t a, uint8_t b) {
+    packed_words_SWAP(QUBIT_PACKED_WORDS(state), a, b);
+}
+
+// ============================================================================
+// Bulk Word Operations
+// ============================================================================
+
+void qubit_packed_NOT_mask(Qubit_State* state, const uint64_t* mask) {
+    if (!state || state->backend_type != QUBIT_BACKEND_PACKED) return;
+
+    Packed_Qubit_State* packed = (Packed_Qubit_State*)state->backend_data;
+    if (packed->word_count == 0) return;
+
+    for (uint32_t i = 0; i < packed->word_count; i++) {
+        packed->words[i] ^= mask[i];
+    }
+    packed->words[packed->word_count - 1] &= packed_tail_mask(state->qubit_count);
+}
+
+void qubit_packed_CNOT_mask(Qubit_State* state, const uint64_t* control_mask, uint32_t offset) {
+    if (!state || state->backend_type != QUBIT_BACKEND_PACKED) return;
+
+    Packed_Qubit_State* packed = (Packed_Qubit_State*)state->backend_data;
+    uint32_t n = packed->word_count;
+    if (n == 0) return;
+
+    uint32_t word_shift = offset / 64;
+    uint32_t bit_shift = offset % 64;
+
+    // Flip mask = (words & control_mask) << offset, built high word first so
+    // the update can run in place without clobbering unread controls
+    for (uint32_t i = n; i-- > word_shift;) {
+        uint32_t src = i - word_shift;
+        uint64_t flip = (packed->words[src] & control_mask[src]) << bit_shift;
+        if (bit_shift && src > 0) {
+            flip |= (packed->words[src - 1] & control_mask[src - 1]) >> (64 - bit_shift);
+        }
+        packed->words[i] ^= flip;
+    }
+    packed->words[n - 1] &= packed_tail_mask(state->qubit_count);
+}
+
+// ============================================================================
+// Measurement (Trivial for Classical)
+// ============================================================================
+
+static uint8_t packed_measure(Qubit_State* state, uint8_t qubit) {
+    return (uint8_t)packed_words_get(QUBIT_PACKED_WORDS(state), qubit);
+}
+
+static double packed_probability(const Qubit_State* state, uint8_t qubit) {
+    return (double)packed_words_get(QUBIT_PACKED_WORDS(state), qubit);
+}
+
+static uint8_t packed_read(const Qubit_State* state, uint8_t qubit) {
+    return (uint8_t)packed_words_get(QUBIT_PACKED_WORDS(state), qubit);
+}
+
+// ============================================================================
+// Backend Info
+// ============================================================================
+
+static const char* packed_name(void) {
+    return "Classical (Bit-Packed)";
+}
+
+static bool packed_is_quantum(void) {
+    return false;
+}
+
+// ============================================================================
+// Operations Table
+// ============================================================================
+
+const Qubit_Backend_Ops packed_backend_ops = {
+    .init = packed_init,
+    .free = packed_free,
+    .clone = packed_clone,
+    .copy = packed_copy,
+    .CCNOT = packed_CCNOT,
+    .CNOT = packed_CNOT,
+    .NOT = packed_NOT,
+    .SWAP = packed_SWAP,
+    .measure = packed_measure,
+    .read = packed_read,
+    .probability = packed_probability,
+    .name = packed_name,
+    .is_quantum = packed_is_quantum
+};
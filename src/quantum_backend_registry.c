@@ -12,13 +12,34 @@
 // ============================================================================
 
 const Qubit_Backend_Ops* get_backend_ops(Qubit_Backend_Type backend) {
+#ifdef MOOP_FIXED_BACKEND
+    // Fixed-backend build: only one backend is linked in
+#ifdef MOOP_FIXED_BACKEND_CLASSICAL
+    const Qubit_Backend_Ops* fixed = &classical_backend_ops;
+#else
+    const Qubit_Backend_Ops* fixed = &packed_backend_ops;
+#endif
+    if (backend != MOOP_FIXED_BACKEND) {
+        fprintf(stderr, "Warning: Fixed-backend build, using %s\n", fixed->name());
+    }
+    return fixed;
+#else
     switch (backend) {
         case QUBIT_BACKEND_CLASSICAL:
             return &classical_backend_ops;
 
+        case QUBIT_BACKEND_PACKED:
+            return &packed_backend_ops;
+
+        case QUBIT_BACKEND_BITSLICED:
+            return &bitsliced_backend_ops;
+
 #ifdef ENABLE_QUANTUM_SIMULATOR
         case QUBIT_BACKEND_SIMULATOR:
             return &quantum_simulator_ops;
+
+        case QUBIT_BACKEND_SPARSE:
+            return &sparse_simulator_ops;
 #endif
 
 #ifdef ENABLE_QUANTUM_HARDWARE
@@ -31,17 +52,27 @@ const Qubit_Backend_Ops* get_backend_ops(Qubit_Backend_Type backend) {
             fprintf(stderr, "Warning: Unknown backend type %d, using classical\n", backend);
             return &classical_backend_ops;
     }
+#endif
 }
 
 const char** list_available_backends(uint32_t* count) {
-    static const char* backends[3];
+    static const char* backends[6];
     uint32_t idx = 0;
 
+#if defined(MOOP_FIXED_BACKEND_CLASSICAL)
+    backends[idx++] = "Classical (Conventional Hardware)";
+#elif defined(MOOP_FIXED_BACKEND_PACKED)
+    backends[idx++] = "Classical (Bit-Packed)";
+#else
     // Classical is always available
     backends[idx++] = "Classical (Conventional Hardware)";
+    backends[idx++] = "Classical (Bit-Packed)";
+    backends[idx++] = "Classical (Bit-Sliced Multi-Instance)";
+#endif
 
 #ifdef ENABLE_QUANTUM_SIMULATOR
     backends[idx++] = "Quantum Simulator (Statevector)";
+    backends[idx++] = "Quantum Simulator (Sparse)";
 #endif
 
 #ifdef ENABLE_QUANTUM_HARDWARE
@@ -62,125 +93,47 @@ Qubit_State* qubit_init(uint32_t n_qubits, Qubit_Backend_Type backend) {
         fprintf(stderr, "Error: Backend init not available\n");
         return NULL;
     }
+
+    // Gates are dispatched through state->ops without further checks,
+    // so reject incomplete tables here, once
+    if (!ops->free || !ops->clone || !ops->copy || !ops->CCNOT || !ops->CNOT ||
+        !ops->NOT || !ops->SWAP || !ops->measure || !ops->read || !ops->probability) {
+        fprintf(stderr, "Error: Backend operations table incomplete\n");
+        return NULL;
+    }
     return ops->init(n_qubits);
 }
 
 void qubit_free(Qubit_State* state) {
     if (!state) return;
-
-    const Qubit_Backend_Ops* ops = get_backend_ops(state->backend_type);
-    if (!ops || !ops->free) {
-        fprintf(stderr, "Error: Backend free not available\n");
-        return;
-    }
-    ops->free(state);
+    state->ops->free(state);
 }
 
 Qubit_State* qubit_clone(const Qubit_State* state) {
     if (!state) return NULL;
-
-    const Qubit_Backend_Ops* ops = get_backend_ops(state->backend_type);
-    if (!ops || !ops->clone) {
-        fprintf(stderr, "Error: Backend clone not available\n");
-        return NULL;
-    }
-    return ops->clone(state);
-}
-
-// ============================================================================
-// Convenience Functions - Gates
-// ============================================================================
-
-void qubit_CCNOT(Qubit_State* state, uint8_t a, uint8_t b, uint8_t c) {
-    if (!state) return;
-
-    const Qubit_Backend_Ops* ops = get_backend_ops(state->backend_type);
-    if (!ops || !ops->CCNOT) {
-        fprintf(stderr, "Error: Backend CCNOT not available\n");
-        return;
-    }
-    ops->CCNOT(state, a, b, c);
-}
-
-void qubit_CNOT(Qubit_State* state, uint8_t a, uint8_t b) {
-    if (!state) return;
-
-    const Qubit_Backend_Ops* ops = get_backend_ops(state->backend_type);
-    if (!ops || !ops->CNOT) {
-        fprintf(stderr, "Error: Backend CNOT not available\n");
-        return;
-    }
-    ops->CNOT(state, a, b);
-}
-
-void qubit_NOT(Qubit_State* state, uint8_t a) {
-    if (!state) return;
-
-    const Qubit_Backend_Ops* ops = get_backend_ops(state->backend_type);
-    if (!ops || !ops->NOT) {
-        fprintf(stderr, "Error: Backend NOT not available\n");
-        return;
-    }
-    ops->NOT(state, a);
-}
-
-void qubit_SWAP(Qubit_State* state, uint8_t a, uint8_t b) {
-    if (!state) return;
-
-    const Qubit_Backend_Ops* ops = get_backend_ops(state->backend_type);
-    if (!ops || !ops->SWAP) {
-        fprintf(stderr, "Error: Backend SWAP not available\n");
-        return;
-    }
-    ops->SWAP(state, a, b);
+    return state->ops->clone(state);
 }
 
-// ============================================================================
-// Convenience Functions - Measurement
-// ============================================================================
-
-uint8_t qubit_measure(Qubit_State* state, uint8_t qubit) {
-    if (!state) return 0;
-
-    const Qubit_Backend_Ops* ops = get_backend_ops(state->backend_type);
-    if (!ops || !ops->measure) {
-        fprintf(stderr, "Error: Backend measure not available\n");
-        return 0;
+bool qubit_copy(Qubit_State* dst, const Qubit_State* src) {
+    if (!dst || !src || dst->ops != src->ops || dst->qubit_count != src->qubit_count) {
+        return false;
     }
-    return ops->measure(state, qubit);
+    src->ops->copy(dst, src);
+    return true;
 }
 
-uint8_t qubit_read(const Qubit_State* state, uint8_t qubit) {
-    if (!state) return 0;
-
-    const Qubit_Backend_Ops* ops = get_backend_ops(state->backend_type);
-    if (!ops || !ops->read) {
-        fprintf(stderr, "Error: Backend read not available\n");
-        return 0;
-    }
-    return ops->read(state, qubit);
-}
+// Gate and measurement dispatch is inline in moop_quantum_ready.h
 
 // ============================================================================
 // Convenience Functions - Info
 // ============================================================================
 
 const char* qubit_backend_name(const Qubit_State* state) {
-    if (!state) return "Unknown";
-
-    const Qubit_Backend_Ops* ops = get_backend_ops(state->backend_type);
-    if (!ops || !ops->name) {
-        return "Unknown";
-    }
-    return ops->name();
+    if (!state || !state->ops->name) return "Unknown";
+    return state->ops->name();
 }
 
 bool qubit_is_quantum(const Qubit_State* state) {
-    if (!state) return false;
-
-    const Qubit_Backend_Ops* ops = get_backend_ops(state->backend_type);
-    if (!ops || !ops->is_quantum) {
-        return false;
-    }
-    return ops->is_quantum();
+    if (!state || !state->ops->is_quantum) return false;
+    return state->ops->is_quantum();
 }
@@ -4,6 +4,7 @@
 // Demonstrates true quantum superposition and entanglement
 
 #define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE  // MAP_ANONYMOUS, MADV_HUGEPAGE
 #include "moop_quantum_ready.h"
 #include <stdlib.h>
 #include <string.h>
@@ -12,6 +13,9 @@
 
 #ifdef ENABLE_QUANTUM_SIMULATOR
 
+#include <pthread.h>
+#include <sys/mman.h>
+
 // ============================================================================
 // Quantum Simulator State Representation
 // ============================================================================
@@ -28,31 +32,520 @@ static inline uint64_t pow2(uint32_t n) {
     return 1ULL << n;
 }
 
-static void normalize_statevector(Quantum_Simulator_State* qstate) {
-    // Calculate norm: Σᵢ |αᵢ|²
-    double norm_sq = 0.0;
-    for (uint64_t i = 0; i < qstate->state_size; i++) {
-        double r = qstate->real_amplitudes[i];
-        double im = qstate->imag_amplitudes[i];
-        norm_sq += r*r + im*im;
+// ============================================================================
+// Amplitude Storage
+// ============================================================================
+
+#define HUGE_PAGE_BYTES ((size_t)2 << 20)
+
+static inline size_t mapped_bytes(uint64_t count) {
+    return (count * sizeof(double) + HUGE_PAGE_BYTES - 1) & ~(HUGE_PAGE_BYTES - 1);
+}
+
+// Zeroed buffer of count doubles, 64-byte aligned. Large buffers are
+// mapped on a huge-page boundary (so transparent huge pages can back all
+// of it) instead of coming from the heap
+static double* alloc_amplitudes(uint64_t count) {
+    size_t bytes = count * sizeof(double);
+    if (bytes < HUGE_PAGE_BYTES) {
+        bytes = (bytes + 63) & ~(size_t)63;
+        double* buffer = aligned_alloc(64, bytes);
+        if (buffer) memset(buffer, 0, bytes);
+        return buffer;
+    }
+
+    // Over-map by one huge page, then trim to an aligned window
+    size_t size = mapped_bytes(count);
+    uint8_t* raw = mmap(NULL, size + HUGE_PAGE_BYTES, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return NULL;
+    uintptr_t start = ((uintptr_t)raw + HUGE_PAGE_BYTES - 1) & ~(uintptr_t)(HUGE_PAGE_BYTES - 1);
+    size_t head = start - (uintptr_t)raw;
+    if (head) munmap(raw, head);
+    if (HUGE_PAGE_BYTES - head) munmap((uint8_t*)start + size, HUGE_PAGE_BYTES - head);
+#ifdef MADV_HUGEPAGE
+    madvise((void*)start, size, MADV_HUGEPAGE);
+#endif
+    return (double*)start;
+}
+
+static void free_amplitudes(double* buffer, uint64_t count) {
+    if (!buffer) return;
+    if (count * sizeof(double) < HUGE_PAGE_BYTES) free(buffer);
+    else munmap(buffer, mapped_bytes(count));
+}
+
+// The arrays a kernel walks: amplitude i of plane p starts at
+// planes[p][i * width]. Split is two planes (re, im) of width 1,
+// interleaved one plane of width 2, so a run of len amplitudes is always
+// len * width consecutive doubles per plane and one kernel serves both
+typedef struct {
+    double* planes[2];
+    uint32_t plane_count;
+    uint32_t width;
+} Amp_View;
+
+// Kernels are written once against (plane_count, width) and instantiated
+// for both layouts, so the per-run loops have constant trip multipliers
+#define LAYOUT_INLINE static inline __attribute__((always_inline))
+#define DISPATCH_LAYOUT(view, kernel, ...) \
+    ((view).width == 2 ? kernel(__VA_ARGS__, 1, 2) : kernel(__VA_ARGS__, 2, 1))
+
+static inline Amp_View amp_view(const Quantum_Simulator_State* qstate) {
+    if (qstate->layout == SIM_LAYOUT_INTERLEAVED) {
+        return (Amp_View){{qstate->amplitudes, NULL}, 1, 2};
+    }
+    return (Amp_View){{qstate->real_amplitudes, qstate->imag_amplitudes}, 2, 1};
+}
+
+static inline void load_amplitude(const Quantum_Simulator_State* qstate, uint64_t i,
+                                  double* re, double* im) {
+    if (qstate->layout == SIM_LAYOUT_INTERLEAVED) {
+        *re = qstate->amplitudes[2 * i];
+        *im = qstate->amplitudes[2 * i + 1];
+    } else {
+        *re = qstate->real_amplitudes[i];
+        *im = qstate->imag_amplitudes[i];
+    }
+}
+
+static inline void store_amplitude(Quantum_Simulator_State* qstate, uint64_t i,
+                                   double re, double im) {
+    if (qstate->layout == SIM_LAYOUT_INTERLEAVED) {
+        qstate->amplitudes[2 * i] = re;
+        qstate->amplitudes[2 * i + 1] = im;
+    } else {
+        qstate->real_amplitudes[i] = re;
+        qstate->imag_amplitudes[i] = im;
+    }
+}
+
+// Allocate zeroed buffers for layout into qstate (state_size set); false
+// on failure with qstate's buffer pointers untouched
+static bool alloc_layout(Quantum_Simulator_State* qstate, Sim_Layout layout) {
+    if (layout == SIM_LAYOUT_INTERLEAVED) {
+        double* amplitudes = alloc_amplitudes(2 * qstate->state_size);
+        if (!amplitudes) return false;
+        qstate->amplitudes = amplitudes;
+        qstate->real_amplitudes = qstate->imag_amplitudes = NULL;
+    } else {
+        double* re = alloc_amplitudes(qstate->state_size);
+        double* im = alloc_amplitudes(qstate->state_size);
+        if (!re || !im) {
+            free_amplitudes(re, qstate->state_size);
+            free_amplitudes(im, qstate->state_size);
+            return false;
+        }
+        qstate->real_amplitudes = re;
+        qstate->imag_amplitudes = im;
+        qstate->amplitudes = NULL;
+    }
+    qstate->layout = layout;
+    return true;
+}
+
+static void free_layout(Quantum_Simulator_State* qstate) {
+    free_amplitudes(qstate->real_amplitudes, qstate->state_size);
+    free_amplitudes(qstate->imag_amplitudes, qstate->state_size);
+    free_amplitudes(qstate->amplitudes, 2 * qstate->state_size);
+    qstate->real_amplitudes = qstate->imag_amplitudes = qstate->amplitudes = NULL;
+}
+
+// ============================================================================
+// Worker Pool
+// ============================================================================
+// A sweep is split into contiguous item ranges, one part per thread; the
+// calling thread runs part 0. One process-wide pool is started lazily and
+// grown to the largest thread count any state asks for. Jobs from
+// different states are serialized.
+// ============================================================================
+
+// Sweeps smaller than this stay on the calling thread
+#define PARALLEL_MIN_ITEMS (1u << 14)
+
+typedef void (*Sim_Task)(void* ctx, uint64_t begin, uint64_t end, uint32_t part);
+
+static struct {
+    pthread_mutex_t submit;     // Held for a whole job
+    pthread_mutex_t lock;       // Guards everything below
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    pthread_t workers[SIM_MAX_THREADS - 1];
+    uint32_t worker_count;      // Worker w runs part w + 1
+    bool shutdown;
+
+    uint64_t generation;        // Bumped per job
+    Sim_Task task;
+    void* ctx;
+    uint64_t items;
+    uint32_t parts;
+    uint32_t remaining;         // Worker parts still running
+} pool = {
+    .submit = PTHREAD_MUTEX_INITIALIZER,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
+
+static inline uint64_t part_start(uint64_t items, uint32_t parts, uint32_t part) {
+    return items * part / parts;
+}
+
+static void* pool_worker(void* arg) {
+    uint32_t part = (uint32_t)(uintptr_t)arg;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool.lock);
+    for (;;) {
+        while (!pool.shutdown && pool.generation == seen) {
+            pthread_cond_wait(&pool.wake, &pool.lock);
+        }
+        if (pool.shutdown) break;
+        seen = pool.generation;
+        if (part >= pool.parts) continue;
+
+        Sim_Task task = pool.task;
+        void* ctx = pool.ctx;
+        uint64_t begin = part_start(pool.items, pool.parts, part);
+        uint64_t end = part_start(pool.items, pool.parts, part + 1);
+        pthread_mutex_unlock(&pool.lock);
+        task(ctx, begin, end, part);
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.remaining == 0) pthread_cond_signal(&pool.done);
+    }
+    pthread_mutex_unlock(&pool.lock);
+    return NULL;
+}
+
+static void pool_shutdown(void) {
+    pthread_mutex_lock(&pool.lock);
+    pool.shutdown = true;
+    pthread_cond_broadcast(&pool.wake);
+    pthread_mutex_unlock(&pool.lock);
+    for (uint32_t w = 0; w < pool.worker_count; w++) pthread_join(pool.workers[w], NULL);
+    pool.worker_count = 0;
+}
+
+// Start workers until threads parts can run (pool.submit held); returns
+// the number of parts actually available
+static uint32_t pool_reserve(uint32_t threads) {
+    if (pool.worker_count == 0 && threads > 1) atexit(pool_shutdown);
+    while (pool.worker_count + 1 < threads) {
+        uint32_t part = pool.worker_count + 1;
+        if (pthread_create(&pool.workers[pool.worker_count], NULL, pool_worker,
+                           (void*)(uintptr_t)part) != 0) {
+            break;
+        }
+        pool.worker_count++;
+    }
+    return (pool.worker_count + 1 < threads) ? pool.worker_count + 1 : threads;
+}
+
+// Run task over items [0, items) split across up to threads parts
+static void parallel_run(uint32_t threads, uint64_t items, Sim_Task task, void* ctx) {
+    if (threads <= 1 || items < PARALLEL_MIN_ITEMS) {
+        task(ctx, 0, items, 0);
+        return;
+    }
+
+    pthread_mutex_lock(&pool.submit);
+    uint32_t parts = pool_reserve(threads);
+    if (parts <= 1) {
+        pthread_mutex_unlock(&pool.submit);
+        task(ctx, 0, items, 0);
+        return;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.task = task;
+    pool.ctx = ctx;
+    pool.items = items;
+    pool.parts = parts;
+    pool.remaining = parts - 1;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.wake);
+    pthread_mutex_unlock(&pool.lock);
+
+    task(ctx, 0, part_start(items, parts, 1), 0);
+
+    pthread_mutex_lock(&pool.lock);
+    while (pool.remaining) pthread_cond_wait(&pool.done, &pool.lock);
+    pthread_mutex_unlock(&pool.lock);
+    pthread_mutex_unlock(&pool.submit);
+}
+
+// ============================================================================
+// Index Walks
+// ============================================================================
+// A gate acts on the indices whose involved bits have a fixed pattern.
+// Those are enumerated by inserting the involved bits into a counter: the
+// indices below the lowest involved bit are consecutive, so item p is
+// offset p % run in block p / run, and any item range splits into
+// unit-stride runs.
+// ============================================================================
+
+typedef struct {
+    uint64_t block_mask;        // Involved bits and every bit below them
+    uint64_t free;              // The other index bits (the block counter)
+    uint64_t run;               // Consecutive indices per block
+    uint64_t items;             // Indices per involved-bit pattern
+} Index_Walk;
+
+typedef struct {
+    uint64_t block;
+    uint64_t offset;
+    uint64_t left;
+} Walk_Cursor;
+
+static Index_Walk index_walk(const Quantum_Simulator_State* qstate, uint64_t involved) {
+    uint64_t run = involved & -involved;
+    uint64_t block_mask = involved | (run - 1);
+    return (Index_Walk){block_mask, (qstate->state_size - 1) & ~block_mask, run,
+                        qstate->state_size >> __builtin_popcountll(involved & (qstate->state_size - 1))};
+}
+
+// Scatter the low bits of k onto the bits set in mask
+static uint64_t deposit_bits(uint64_t k, uint64_t mask) {
+    uint64_t out = 0;
+    for (; mask && k; mask &= mask - 1, k >>= 1) {
+        if (k & 1) out |= mask & -mask;
+    }
+    return out;
+}
+
+static inline Walk_Cursor walk_start(const Index_Walk* w, uint64_t begin, uint64_t end) {
+    uint64_t block = deposit_bits(begin >> __builtin_ctzll(w->run), w->free);
+    return (Walk_Cursor){block, begin & (w->run - 1), end - begin};
+}
+
+// Next run of indices [*base, *base + *len); false when the range is done
+static inline bool walk_next(const Index_Walk* w, Walk_Cursor* c, uint64_t* base, uint64_t* len) {
+    if (c->left == 0) return false;
+    uint64_t n = w->run - c->offset;
+    if (n > c->left) n = c->left;
+    *base = c->block + c->offset;
+    *len = n;
+    c->left -= n;
+    c->offset = 0;
+    c->block = ((c->block | w->block_mask) + 1) & ~w->block_mask;
+    return true;
+}
+
+// ============================================================================
+// Normalization
+// ============================================================================
+
+typedef struct {
+    Amp_View view;
+    Index_Walk walk;            // Reductions: the indices summed
+    double scale;
+    double partial[SIM_MAX_THREADS];
+} Norm_Task;
+
+LAYOUT_INLINE double norm_runs(const Norm_Task* task, uint64_t begin, uint64_t end,
+                               uint32_t plane_count, uint32_t width) {
+    Walk_Cursor c = walk_start(&task->walk, begin, end);
+    uint64_t base, len;
+    double sum = 0.0;
+    while (walk_next(&task->walk, &c, &base, &len)) {
+        for (uint32_t p = 0; p < plane_count; p++) {
+            const double* x = task->view.planes[p] + base * width;
+            for (uint64_t t = 0; t < len * width; t++) sum += x[t] * x[t];
+        }
+    }
+    return sum;
+}
+
+static void norm_task(void* ctx, uint64_t begin, uint64_t end, uint32_t part) {
+    Norm_Task* task = ctx;
+    task->partial[part] = DISPATCH_LAYOUT(task->view, norm_runs, task, begin, end);
+}
+
+static void scale_task(void* ctx, uint64_t begin, uint64_t end, uint32_t part) {
+    (void)part;
+    Norm_Task* task = ctx;
+    const Amp_View* v = &task->view;
+    for (uint32_t p = 0; p < v->plane_count; p++) {
+        double* x = v->planes[p];
+        for (uint64_t t = begin * v->width; t < end * v->width; t++) x[t] *= task->scale;
     }
+}
+
+// Σ |αᵢ|² over the indices with the involved bits clear
+static double sum_probabilities(Quantum_Simulator_State* qstate, uint64_t involved) {
+    Norm_Task task = {.view = amp_view(qstate), .walk = index_walk(qstate, involved)};
+    parallel_run(qstate->threads, task.walk.items, norm_task, &task);
+
+    double sum = 0.0;
+    for (uint32_t p = 0; p < SIM_MAX_THREADS; p++) sum += task.partial[p];
+    return sum;
+}
+
+static void forget_probabilities(Quantum_Simulator_State* qstate);
+
+static void normalize_statevector(Quantum_Simulator_State* qstate) {
+    forget_probabilities(qstate);
+
+    // Calculate norm: Σᵢ |αᵢ|² (the walk needs one involved bit: take
+    // the bit above the register, which every index has clear)
+    double norm_sq = sum_probabilities(qstate, qstate->state_size);
 
     if (norm_sq < 1e-10) {
         // Degenerate state - reinitialize to |0⟩
-        qstate->real_amplitudes[0] = 1.0;
-        qstate->imag_amplitudes[0] = 0.0;
-        for (uint64_t i = 1; i < qstate->state_size; i++) {
-            qstate->real_amplitudes[i] = 0.0;
-            qstate->imag_amplitudes[i] = 0.0;
+        Amp_View v = amp_view(qstate);
+        for (uint32_t p = 0; p < v.plane_count; p++) {
+            memset(v.planes[p], 0, qstate->state_size * v.width * sizeof(double));
         }
+        store_amplitude(qstate, 0, 1.0, 0.0);
         return;
     }
 
-    double norm = sqrt(norm_sq);
-    for (uint64_t i = 0; i < qstate->state_size; i++) {
-        qstate->real_amplitudes[i] /= norm;
-        qstate->imag_amplitudes[i] /= norm;
+    Norm_Task task = {.view = amp_view(qstate), .scale = 1.0 / sqrt(norm_sq)};
+    parallel_run(qstate->threads, qstate->state_size, scale_task, &task);
+}
+
+// ============================================================================
+// Probability Cache
+// ============================================================================
+// One sweep takes every qubit's marginal Σ|αᵢ|² (over i with the qubit
+// set) and the probability of each block of consecutive amplitudes: a
+// histogram over the offset inside the block covers the low qubits, and
+// each block's sum is credited to the high qubits set in its index. Gates
+// permute basis states, so NOT and SWAP map the cached marginals exactly,
+// and so does a controlled gate whose controls are certain (the usual case
+// for circuits run on basis states); otherwise its target is swept again.
+// ============================================================================
+
+#define PROB_BLOCK_BITS 8
+
+// Amplitudes per block of the cumulative table
+static inline uint64_t prob_block(const Quantum_Simulator_State* qstate) {
+    return qstate->state_size < pow2(PROB_BLOCK_BITS) ? qstate->state_size : pow2(PROB_BLOCK_BITS);
+}
+
+static void forget_probabilities(Quantum_Simulator_State* qstate) {
+    qstate->marginal_valid = 0;
+    qstate->blocks_valid = false;
+}
+
+static inline void probabilities_NOT(Quantum_Simulator_State* qstate, uint8_t target) {
+    qstate->marginals[target] = qstate->marginal_total - qstate->marginals[target];
+    qstate->blocks_valid = false;
+}
+
+static inline void probabilities_SWAP(Quantum_Simulator_State* qstate, uint8_t a, uint8_t b) {
+    double m = qstate->marginals[a];
+    qstate->marginals[a] = qstate->marginals[b];
+    qstate->marginals[b] = m;
+    uint64_t differ = ((qstate->marginal_valid >> a) ^ (qstate->marginal_valid >> b)) & 1;
+    qstate->marginal_valid ^= differ * (pow2(a) | pow2(b));
+    qstate->blocks_valid = false;
+}
+
+// 1 or 0 when the cached marginal leaves no doubt, -1 otherwise. Exact
+// comparisons: a basis state's sums are exact, anything else falls back
+static inline int certain_value(const Quantum_Simulator_State* qstate, uint8_t qubit) {
+    if (!((qstate->marginal_valid >> qubit) & 1)) return -1;
+    if (qstate->marginals[qubit] == 0.0) return 0;
+    if (qstate->marginals[qubit] == qstate->marginal_total) return 1;
+    return -1;
+}
+
+static inline void probabilities_controlled(Quantum_Simulator_State* qstate, const uint8_t* controls,
+                                            uint32_t count, uint8_t target) {
+    qstate->blocks_valid = false;
+    bool all_set = true;
+    for (uint32_t i = 0; i < count; i++) {
+        if (controls[i] == target) return;  // No-op gate
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        int value = certain_value(qstate, controls[i]);
+        if (value == 0) return;  // Never fires
+        if (value < 0) all_set = false;
+    }
+    if (all_set) probabilities_NOT(qstate, target);  // Always fires
+    else qstate->marginal_valid &= ~pow2(target);
+}
+
+typedef struct {
+    Amp_View view;
+    uint64_t block;             // Amplitudes per block
+    double* blocks;             // Probability of each block
+    double* rows;               // Per part: block-offset histogram, then 64 high-qubit sums
+} Prob_Task;
+
+LAYOUT_INLINE void prob_runs(const Prob_Task* task, uint64_t first, uint64_t last,
+                             double* low, double* high, uint32_t plane_count, uint32_t width) {
+    uint64_t n = task->block;
+    uint32_t shift = (uint32_t)__builtin_ctzll(n);
+    double p[1u << PROB_BLOCK_BITS];
+    for (uint64_t b = first; b < last; b++) {
+        for (uint64_t t = 0; t < n; t++) p[t] = 0.0;
+        for (uint32_t q = 0; q < plane_count; q++) {
+            const double* x = task->view.planes[q] + b * n * width;
+            for (uint64_t t = 0; t < n; t++) {
+                double s = 0.0;
+                for (uint32_t w = 0; w < width; w++) s += x[t * width + w] * x[t * width + w];
+                p[t] += s;
+            }
+        }
+
+        // Four partial sums keep the block total off one long add chain
+        double sum[4] = {0.0, 0.0, 0.0, 0.0};
+        for (uint64_t t = 0; t < n; t++) {
+            low[t] += p[t];
+            sum[t & 3] += p[t];
+        }
+        double block = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+        task->blocks[b] = block;
+        for (uint64_t m = b; m; m &= m - 1) high[shift + __builtin_ctzll(m)] += block;
+    }
+}
+
+// A part owns the blocks that start inside its index range
+static void prob_task(void* ctx, uint64_t begin, uint64_t end, uint32_t part) {
+    Prob_Task* task = ctx;
+    uint64_t first = (begin + task->block - 1) / task->block;
+    uint64_t last = (end + task->block - 1) / task->block;
+    double* low = task->rows + (size_t)part * (task->block + 64);
+    DISPATCH_LAYOUT(task->view, prob_runs, task, first, last, low, low + task->block);
+}
+
+// Refresh the marginals and the cumulative block table (queued gates must
+// be flushed); false if the tables cannot be allocated
+static bool sweep_probabilities(Quantum_Simulator_State* qstate) {
+    uint64_t block = prob_block(qstate);
+    uint64_t blocks = qstate->state_size / block;
+    if (!qstate->block_cumulative) {
+        qstate->block_cumulative = malloc(blocks * sizeof(double));
+        if (!qstate->block_cumulative) return false;
+    }
+    size_t stride = block + 64;
+    double* rows = calloc((size_t)qstate->threads * stride, sizeof(double));
+    if (!rows) return false;
+
+    Prob_Task task = {amp_view(qstate), block, qstate->block_cumulative, rows};
+    parallel_run(qstate->threads, qstate->state_size, prob_task, &task);
+
+    uint32_t shift = (uint32_t)__builtin_ctzll(block);
+    uint32_t qubits = (uint32_t)__builtin_ctzll(qstate->state_size);
+    double total = 0.0;
+    for (uint32_t q = 0; q < qubits; q++) qstate->marginals[q] = 0.0;
+    for (uint32_t part = 0; part < qstate->threads; part++) {
+        const double* low = rows + (size_t)part * stride;
+        for (uint64_t t = 0; t < block; t++) {
+            total += low[t];
+            for (uint64_t m = t; m; m &= m - 1) qstate->marginals[__builtin_ctzll(m)] += low[t];
+        }
+        for (uint32_t q = shift; q < qubits; q++) qstate->marginals[q] += low[block + q];
     }
+    free(rows);
+
+    for (uint64_t b = 1; b < blocks; b++) qstate->block_cumulative[b] += qstate->block_cumulative[b - 1];
+    qstate->marginal_total = total;
+    qstate->marginal_valid = qstate->state_size - 1;
+    qstate->blocks_valid = true;
+    return true;
 }
 
 // ============================================================================
@@ -72,6 +565,7 @@ static Qubit_State* quantum_simulator_init(uint32_t n_qubits) {
     if (!state) return NULL;
 
     state->backend_type = QUBIT_BACKEND_SIMULATOR;
+    state->ops = &quantum_simulator_ops;
     state->qubit_count = n_qubits;
     state->metadata = NULL;
 
@@ -82,20 +576,28 @@ static Qubit_State* quantum_simulator_init(uint32_t n_qubits) {
     }
 
     qstate->state_size = pow2(n_qubits);
-    qstate->real_amplitudes = calloc(qstate->state_size, sizeof(double));
-    qstate->imag_amplitudes = calloc(qstate->state_size, sizeof(double));
-
-    if (!qstate->real_amplitudes || !qstate->imag_amplitudes) {
-        free(qstate->real_amplitudes);
-        free(qstate->imag_amplitudes);
+    if (!alloc_layout(qstate, SIM_LAYOUT_SPLIT)) {
         free(qstate);
         free(state);
         return NULL;
     }
 
     // Initialize to |0...0⟩ state
-    qstate->real_amplitudes[0] = 1.0;
-    qstate->imag_amplitudes[0] = 0.0;
+    store_amplitude(qstate, 0, 1.0, 0.0);
+
+    qstate->fusion = true;
+    qstate->threads = 1;
+    qstate->pending_count = 0;
+    qstate->pending_mask = 0;
+    qstate->sweeps = 0;
+
+    // Built on the first query: the amplitudes may be written directly
+    // before then
+    memset(qstate->marginals, 0, sizeof(qstate->marginals));
+    qstate->marginal_total = 0.0;
+    qstate->marginal_valid = 0;
+    qstate->block_cumulative = NULL;
+    qstate->blocks_valid = false;
 
     state->backend_data = qstate;
     return state;
@@ -108,29 +610,60 @@ static void quantum_simulator_free(Qubit_State* state) {
         (Quantum_Simulator_State*)state->backend_data;
 
     if (qstate) {
-        free(qstate->real_amplitudes);
-        free(qstate->imag_amplitudes);
+        free_layout(qstate);
+        free(qstate->block_cumulative);
         free(qstate);
     }
 
     free(state);
 }
 
+static void apply_pending(Qubit_State* state);
+
+static void quantum_simulator_copy(Qubit_State* dst_state, const Qubit_State* src_state) {
+    // Queued gates are part of the logical state: apply them first
+    apply_pending((Qubit_State*)src_state);
+
+    const Quantum_Simulator_State* src =
+        (const Quantum_Simulator_State*)src_state->backend_data;
+    Quantum_Simulator_State* dst =
+        (Quantum_Simulator_State*)dst_state->backend_data;
+
+    dst->pending_count = 0;
+    dst->pending_mask = 0;
+    memcpy(dst->marginals, src->marginals, sizeof(dst->marginals));
+    dst->marginal_total = src->marginal_total;
+    dst->marginal_valid = src->marginal_valid;
+    dst->blocks_valid = false;
+    if (dst->layout == src->layout) {
+        Amp_View from = amp_view(src), to = amp_view(dst);
+        for (uint32_t p = 0; p < from.plane_count; p++) {
+            memcpy(to.planes[p], from.planes[p], src->state_size * from.width * sizeof(double));
+        }
+        return;
+    }
+    for (uint64_t i = 0; i < src->state_size; i++) {
+        double re, im;
+        load_amplitude(src, i, &re, &im);
+        store_amplitude(dst, i, re, im);
+    }
+}
+
 static Qubit_State* quantum_simulator_clone(const Qubit_State* state) {
     if (!state) return NULL;
 
     Qubit_State* cloned = quantum_simulator_init(state->qubit_count);
     if (!cloned) return NULL;
 
-    Quantum_Simulator_State* src =
-        (Quantum_Simulator_State*)state->backend_data;
-    Quantum_Simulator_State* dst =
-        (Quantum_Simulator_State*)cloned->backend_data;
-
-    memcpy(dst->real_amplitudes, src->real_amplitudes,
-           src->state_size * sizeof(double));
-    memcpy(dst->imag_amplitudes, src->imag_amplitudes,
-           src->state_size * sizeof(double));
+    const Quantum_Simulator_State* src = (const Quantum_Simulator_State*)state->backend_data;
+    Quantum_Simulator_State* dst = (Quantum_Simulator_State*)cloned->backend_data;
+    if (!quantum_simulator_set_layout(cloned, src->layout)) {
+        quantum_simulator_free(cloned);
+        return NULL;
+    }
+    quantum_simulator_copy(cloned, state);
+    dst->fusion = src->fusion;
+    dst->threads = src->threads;
 
     return cloned;
 }
@@ -143,167 +676,650 @@ static Qubit_State* quantum_simulator_clone(const Qubit_State* state) {
 //   |ψ'⟩ = G|ψ⟩
 // ============================================================================
 
-static void quantum_simulator_NOT(Qubit_State* state, uint8_t target) {
-    Quantum_Simulator_State* qstate =
-        (Quantum_Simulator_State*)state->backend_data;
+// Every gate swaps amplitude pairs: i has the bits in set, the other
+// involved bits clear, and j = i ^ flip. Only those pairs are walked.
+typedef struct {
+    Amp_View view;
+    Index_Walk walk;
+    uint64_t set;
+    uint64_t flip;
+} Swap_Task;
+
+LAYOUT_INLINE void swap_runs(const Swap_Task* task, uint64_t begin, uint64_t end,
+                             uint32_t plane_count, uint32_t width) {
+    Walk_Cursor c = walk_start(&task->walk, begin, end);
+    uint64_t base, len;
+    while (walk_next(&task->walk, &c, &base, &len)) {
+        uint64_t i = (base | task->set) * width;
+        uint64_t j = ((base | task->set) ^ task->flip) * width;
+        for (uint32_t p = 0; p < plane_count; p++) {
+            double* restrict x = task->view.planes[p] + i;
+            double* restrict y = task->view.planes[p] + j;
+            for (uint64_t t = 0; t < len * width; t++) {
+                double temp = x[t];
+                x[t] = y[t];
+                y[t] = temp;
+            }
+        }
+    }
+}
+
+static void swap_task(void* ctx, uint64_t begin, uint64_t end, uint32_t part) {
+    (void)part;
+    Swap_Task* task = ctx;
+    DISPATCH_LAYOUT(task->view, swap_runs, task, begin, end);
+}
 
-    uint64_t target_mask = pow2(target);
+static void swap_pairs(Quantum_Simulator_State* qstate, uint64_t involved,
+                       uint64_t set, uint64_t flip) {
+    Swap_Task task = {amp_view(qstate), index_walk(qstate, involved), set, flip};
+    parallel_run(qstate->threads, task.walk.items, swap_task, &task);
+}
 
+static void sweep_NOT(Quantum_Simulator_State* qstate, uint8_t target) {
     // NOT gate: swap amplitudes for basis states differing in target qubit
-    for (uint64_t i = 0; i < qstate->state_size; i++) {
-        if (i & target_mask) continue; // Already processed
+    swap_pairs(qstate, pow2(target), 0, pow2(target));
+}
 
-        uint64_t j = i | target_mask; // Flip target bit
+static void sweep_CNOT(Quantum_Simulator_State* qstate, uint8_t control, uint8_t target) {
+    // CNOT: flip target if control is 1
+    if (control == target) return;
+    swap_pairs(qstate, pow2(control) | pow2(target), pow2(control), pow2(target));
+}
 
-        // Swap amplitudes
-        double temp_r = qstate->real_amplitudes[i];
-        double temp_im = qstate->imag_amplitudes[i];
+static void sweep_CCNOT(Quantum_Simulator_State* qstate, uint8_t ctrl1, uint8_t ctrl2, uint8_t target) {
+    // CCNOT (Toffoli): flip target if both controls are 1
+    if (target == ctrl1 || target == ctrl2) return;
+    uint64_t controls = pow2(ctrl1) | pow2(ctrl2);
+    swap_pairs(qstate, controls | pow2(target), controls, pow2(target));
+}
 
-        qstate->real_amplitudes[i] = qstate->real_amplitudes[j];
-        qstate->imag_amplitudes[i] = qstate->imag_amplitudes[j];
+static void sweep_SWAP(Quantum_Simulator_State* qstate, uint8_t qubit1, uint8_t qubit2) {
+    // SWAP: exchange |..1..0..⟩ and |..0..1..⟩ amplitudes
+    if (qubit1 == qubit2) return;
+    uint64_t both = pow2(qubit1) | pow2(qubit2);
+    swap_pairs(qstate, both, pow2(qubit1), both);
+}
 
-        qstate->real_amplitudes[j] = temp_r;
-        qstate->imag_amplitudes[j] = temp_im;
+// ============================================================================
+// Gate Fusion
+// ============================================================================
+// A queued run over k ≤ SIM_FUSE_QUBITS distinct qubits acts only on those
+// k index bits, so it is a permutation T of the 2^k local patterns. T is
+// built by pushing every pattern through the queue, split into cycles, and
+// applied in place once per setting of the other n - k bits: each
+// amplitude is moved at most once however many gates were fused.
+// ============================================================================
+
+#define FUSE_PATTERNS (1u << SIM_FUSE_QUBITS)
+
+// Apply one gate to a local pattern (operands already mapped to local bits)
+static inline uint32_t local_gate(uint32_t x, Sim_Gate g) {
+    switch (g.gate) {
+        case 0: return x ^ (((x >> g.a) & (x >> g.b) & 1u) << g.c);
+        case 1: return x ^ (((x >> g.a) & 1u) << g.b);
+        case 2: return x ^ (1u << g.a);
+        default: {
+            uint32_t diff = ((x >> g.a) ^ (x >> g.b)) & 1u;
+            return x ^ (diff << g.a) ^ (diff << g.b);
+        }
     }
 }
 
-static void quantum_simulator_CNOT(Qubit_State* state, uint8_t control, uint8_t target) {
-    Quantum_Simulator_State* qstate =
-        (Quantum_Simulator_State*)state->backend_data;
-
-    uint64_t control_mask = pow2(control);
-    uint64_t target_mask = pow2(target);
+// Rotate the amplitudes of each cycle at every base index outside the
+// fused qubits. offsets holds the cycles back to back (as offsets into a
+// plane, already scaled by the view width), lengths their sizes
+typedef struct {
+    Amp_View view;
+    Index_Walk walk;
+    const uint64_t* offsets;
+    const uint32_t* lengths;
+    uint32_t cycle_count;
+} Cycle_Task;
+
+LAYOUT_INLINE void cycle_runs(const Cycle_Task* task, uint64_t begin, uint64_t end,
+                              uint32_t plane_count, uint32_t width) {
+    Walk_Cursor cursor = walk_start(&task->walk, begin, end);
+    uint64_t block, run;
+    while (walk_next(&task->walk, &cursor, &block, &run)) {
+        uint64_t n = run * width;
+        for (uint32_t p = 0; p < plane_count; p++) {
+            double* x = task->view.planes[p] + block * width;
+            const uint64_t* cycle = task->offsets;
+            for (uint32_t c = 0; c < task->cycle_count; c++) {
+                uint32_t len = task->lengths[c];
+                if (len == 2) {
+                    double* restrict x0 = x + cycle[0];
+                    double* restrict x1 = x + cycle[1];
+                    for (uint64_t t = 0; t < n; t++) {
+                        double temp = x0[t];
+                        x0[t] = x1[t];
+                        x1[t] = temp;
+                    }
+                } else {
+                    // cycle[j + 1] = T(cycle[j]): each amplitude moves one step on
+                    for (uint64_t t = 0; t < n; t++) {
+                        double temp = x[cycle[len - 1] + t];
+                        for (uint32_t j = len - 1; j > 0; j--) {
+                            x[cycle[j] + t] = x[cycle[j - 1] + t];
+                        }
+                        x[cycle[0] + t] = temp;
+                    }
+                }
+                cycle += len;
+            }
+        }
+    }
+}
 
-    // CNOT: flip target if control is 1
-    for (uint64_t i = 0; i < qstate->state_size; i++) {
-        // Only act when control bit is 1 and we haven't processed this pair
-        if (!(i & control_mask)) continue;
-        if (i & target_mask) continue;
+static void cycle_task(void* ctx, uint64_t begin, uint64_t end, uint32_t part) {
+    (void)part;
+    Cycle_Task* task = ctx;
+    DISPATCH_LAYOUT(task->view, cycle_runs, task, begin, end);
+}
 
-        uint64_t j = i | target_mask; // Flip target bit
+static void apply_pending(Qubit_State* state) {
+    Quantum_Simulator_State* qstate = (Quantum_Simulator_State*)state->backend_data;
+    if (qstate->pending_count == 0) return;
+
+    // Local bit j stands for the j-th lowest qubit in the mask
+    uint8_t local[64];
+    uint64_t bit_of[SIM_FUSE_QUBITS];
+    uint32_t k = 0;
+    for (uint64_t m = qstate->pending_mask; m; m &= m - 1) {
+        uint8_t q = (uint8_t)__builtin_ctzll(m);
+        local[q] = (uint8_t)k;
+        bit_of[k++] = pow2(q);
+    }
 
-        // Swap amplitudes
-        double temp_r = qstate->real_amplitudes[i];
-        double temp_im = qstate->imag_amplitudes[i];
+    Sim_Gate gates[SIM_FUSE_GATES];
+    for (uint32_t i = 0; i < qstate->pending_count; i++) {
+        Sim_Gate g = qstate->pending[i];
+        gates[i] = (Sim_Gate){g.gate, local[g.a], local[g.b], local[g.c]};
+    }
 
-        qstate->real_amplitudes[i] = qstate->real_amplitudes[j];
-        qstate->imag_amplitudes[i] = qstate->imag_amplitudes[j];
+    uint32_t patterns = 1u << k;
+    uint32_t perm[FUSE_PATTERNS];
+    uint64_t offset[FUSE_PATTERNS];
+    for (uint32_t x = 0; x < patterns; x++) {
+        uint32_t y = x;
+        for (uint32_t i = 0; i < qstate->pending_count; i++) y = local_gate(y, gates[i]);
+        perm[x] = y;
+
+        offset[x] = 0;
+        for (uint32_t j = 0; j < k; j++) {
+            if ((x >> j) & 1) offset[x] |= bit_of[j];
+        }
+    }
 
-        qstate->real_amplitudes[j] = temp_r;
-        qstate->imag_amplitudes[j] = temp_im;
+    // Split T into cycles, dropping fixed points
+    Amp_View view = amp_view(qstate);
+    uint64_t offsets[FUSE_PATTERNS];
+    uint32_t lengths[FUSE_PATTERNS / 2];
+    bool seen[FUSE_PATTERNS] = {false};
+    uint32_t cycle_count = 0, used = 0;
+    for (uint32_t x = 0; x < patterns; x++) {
+        if (seen[x] || perm[x] == x) continue;
+        uint32_t len = 0;
+        for (uint32_t y = x; !seen[y]; y = perm[y]) {
+            seen[y] = true;
+            offsets[used + len++] = offset[y] * view.width;
+        }
+        lengths[cycle_count++] = len;
+        used += len;
     }
-}
 
-static void quantum_simulator_CCNOT(Qubit_State* state, uint8_t ctrl1, uint8_t ctrl2, uint8_t target) {
-    Quantum_Simulator_State* qstate =
-        (Quantum_Simulator_State*)state->backend_data;
+    qstate->pending_count = 0;
+    qstate->pending_mask = 0;
+    if (cycle_count == 0) return;  // The run composed to the identity
 
-    uint64_t ctrl1_mask = pow2(ctrl1);
-    uint64_t ctrl2_mask = pow2(ctrl2);
-    uint64_t target_mask = pow2(target);
+    Cycle_Task task = {view, index_walk(qstate, offset[patterns - 1]), offsets, lengths,
+                       cycle_count};
+    parallel_run(qstate->threads, task.walk.items, cycle_task, &task);
+    qstate->sweeps++;
+}
 
-    // CCNOT (Toffoli): flip target if both controls are 1
-    for (uint64_t i = 0; i < qstate->state_size; i++) {
-        // Only act when both control bits are 1
-        if (!(i & ctrl1_mask)) continue;
-        if (!(i & ctrl2_mask)) continue;
-        if (i & target_mask) continue;
+// Callers may write the amplitudes next, which the cache cannot follow
+void quantum_simulator_flush(Qubit_State* state) {
+    apply_pending(state);
+    forget_probabilities((Quantum_Simulator_State*)state->backend_data);
+}
 
-        uint64_t j = i | target_mask; // Flip target bit
+void quantum_simulator_set_fusion(Qubit_State* state, bool enabled) {
+    Quantum_Simulator_State* qstate = (Quantum_Simulator_State*)state->backend_data;
+    if (!enabled) apply_pending(state);
+    qstate->fusion = enabled;
+}
 
-        // Swap amplitudes
-        double temp_r = qstate->real_amplitudes[i];
-        double temp_im = qstate->imag_amplitudes[i];
+void quantum_simulator_set_threads(Qubit_State* state, uint32_t threads) {
+    Quantum_Simulator_State* qstate = (Quantum_Simulator_State*)state->backend_data;
+    if (threads < 1) threads = 1;
+    if (threads > SIM_MAX_THREADS) threads = SIM_MAX_THREADS;
+    qstate->threads = threads;
+}
 
-        qstate->real_amplitudes[i] = qstate->real_amplitudes[j];
-        qstate->imag_amplitudes[i] = qstate->imag_amplitudes[j];
+bool quantum_simulator_set_layout(Qubit_State* state, Sim_Layout layout) {
+    Quantum_Simulator_State* qstate = (Quantum_Simulator_State*)state->backend_data;
+    apply_pending(state);
+    if (qstate->layout == layout) return true;
 
-        qstate->real_amplitudes[j] = temp_r;
-        qstate->imag_amplitudes[j] = temp_im;
+    Quantum_Simulator_State converted = *qstate;
+    if (!alloc_layout(&converted, layout)) return false;
+    for (uint64_t i = 0; i < qstate->state_size; i++) {
+        double re, im;
+        load_amplitude(qstate, i, &re, &im);
+        store_amplitude(&converted, i, re, im);
     }
+    free_layout(qstate);
+    *qstate = converted;
+    return true;
 }
 
-static void quantum_simulator_SWAP(Qubit_State* state, uint8_t qubit1, uint8_t qubit2) {
-    Quantum_Simulator_State* qstate =
-        (Quantum_Simulator_State*)state->backend_data;
+void quantum_simulator_get_amplitude(Qubit_State* state, uint64_t index, double* re, double* im) {
+    apply_pending(state);
+    load_amplitude((const Quantum_Simulator_State*)state->backend_data, index, re, im);
+}
 
-    uint64_t mask1 = pow2(qubit1);
-    uint64_t mask2 = pow2(qubit2);
+void quantum_simulator_set_amplitude(Qubit_State* state, uint64_t index, double re, double im) {
+    apply_pending(state);
+    forget_probabilities((Quantum_Simulator_State*)state->backend_data);
+    store_amplitude((Quantum_Simulator_State*)state->backend_data, index, re, im);
+}
 
-    // SWAP: exchange qubits (swap amplitudes for states differing in these bits)
-    for (uint64_t i = 0; i < qstate->state_size; i++) {
-        uint8_t bit1 = (i & mask1) ? 1 : 0;
-        uint8_t bit2 = (i & mask2) ? 1 : 0;
-
-        if (bit1 == bit2) continue; // Same state after swap
-
-        // Compute swapped index
-        uint64_t j = i;
-        if (bit1) {
-            j &= ~mask1; // Clear bit1
-            j |= mask2;  // Set bit2
-        } else {
-            j |= mask1;  // Set bit1
-            j &= ~mask2; // Clear bit2
-        }
+// Queue a gate, flushing first when it would overflow the run
+static void fuse_gate(Qubit_State* state, Sim_Gate g, uint32_t operands) {
+    Quantum_Simulator_State* qstate = (Quantum_Simulator_State*)state->backend_data;
+    uint8_t qubits[3] = {g.a, g.b, g.c};
+    uint64_t mask = 0;
+    for (uint32_t i = 0; i < operands; i++) mask |= pow2(qubits[i]);
+
+    uint64_t merged = qstate->pending_mask | mask;
+    if (qstate->pending_count == SIM_FUSE_GATES ||
+        __builtin_popcountll(merged) > SIM_FUSE_QUBITS) {
+        apply_pending(state);
+        merged = mask;
+    }
+    qstate->pending[qstate->pending_count++] = g;
+    qstate->pending_mask = merged;
+}
 
-        if (i >= j) continue; // Only process each pair once
+// Gates with a repeated operand other than CCNOT's two controls leave the
+// statevector unchanged (the sweeps never find an index to act on)
+static void quantum_simulator_NOT(Qubit_State* state, uint8_t target) {
+    Quantum_Simulator_State* qstate = (Quantum_Simulator_State*)state->backend_data;
+    probabilities_NOT(qstate, target);
+    if (!qstate->fusion) {
+        sweep_NOT(qstate, target);
+        qstate->sweeps++;
+        return;
+    }
+    fuse_gate(state, (Sim_Gate){2, target, target, target}, 1);
+}
 
-        // Swap amplitudes
-        double temp_r = qstate->real_amplitudes[i];
-        double temp_im = qstate->imag_amplitudes[i];
+static void quantum_simulator_CNOT(Qubit_State* state, uint8_t control, uint8_t target) {
+    Quantum_Simulator_State* qstate = (Quantum_Simulator_State*)state->backend_data;
+    probabilities_controlled(qstate, &control, 1, target);
+    if (!qstate->fusion) {
+        sweep_CNOT(qstate, control, target);
+        qstate->sweeps++;
+        return;
+    }
+    if (control == target) return;
+    fuse_gate(state, (Sim_Gate){1, control, target, target}, 2);
+}
 
-        qstate->real_amplitudes[i] = qstate->real_amplitudes[j];
-        qstate->imag_amplitudes[i] = qstate->imag_amplitudes[j];
+static void quantum_simulator_CCNOT(Qubit_State* state, uint8_t ctrl1, uint8_t ctrl2, uint8_t target) {
+    Quantum_Simulator_State* qstate = (Quantum_Simulator_State*)state->backend_data;
+    probabilities_controlled(qstate, (const uint8_t[2]){ctrl1, ctrl2}, 2, target);
+    if (!qstate->fusion) {
+        sweep_CCNOT(qstate, ctrl1, ctrl2, target);
+        qstate->sweeps++;
+        return;
+    }
+    if (target == ctrl1 || target == ctrl2) return;
+    fuse_gate(state, (Sim_Gate){0, ctrl1, ctrl2, target}, 3);
+}
 
-        qstate->real_amplitudes[j] = temp_r;
-        qstate->imag_amplitudes[j] = temp_im;
+static void quantum_simulator_SWAP(Qubit_State* state, uint8_t qubit1, uint8_t qubit2) {
+    Quantum_Simulator_State* qstate = (Quantum_Simulator_State*)state->backend_data;
+    probabilities_SWAP(qstate, qubit1, qubit2);
+    if (!qstate->fusion) {
+        sweep_SWAP(qstate, qubit1, qubit2);
+        qstate->sweeps++;
+        return;
     }
+    if (qubit1 == qubit2) return;
+    fuse_gate(state, (Sim_Gate){3, qubit1, qubit2, qubit2}, 2);
 }
 
 // ============================================================================
 // Measurement (Collapses Quantum State)
 // ============================================================================
 
-static uint8_t quantum_simulator_measure(Qubit_State* state, uint8_t qubit) {
-    Quantum_Simulator_State* qstate =
-        (Quantum_Simulator_State*)state->backend_data;
+// Qubits measured jointly per sweep (2^MEASURE_CHUNK outcome patterns)
+#define MEASURE_CHUNK 10
+
+// A joint measurement walks the indices with the measured bits clear; each
+// base plus offsets[k] is the amplitude with outcome pattern k. Pass 1
+// sums every pattern's probability, pass 2 scales the surviving pattern
+// by 1/sqrt(p) and zeroes the rest: two sweeps for any number of qubits,
+// with no separate renormalization.
+typedef struct {
+    Amp_View view;
+    Index_Walk walk;
+    const uint64_t* offsets;
+    uint32_t patterns;
+    double* histogram;          // Pass 1: patterns entries per part
+    uint32_t keep;              // Pass 2: the sampled pattern
+    double scale;
+} Measure_Task;
+
+LAYOUT_INLINE void histogram_runs(const Measure_Task* task, uint64_t begin, uint64_t end,
+                                  double* sums, uint32_t plane_count, uint32_t width) {
+    Walk_Cursor c = walk_start(&task->walk, begin, end);
+    uint64_t base, len;
+    while (walk_next(&task->walk, &c, &base, &len)) {
+        for (uint32_t k = 0; k < task->patterns; k++) {
+            double sum = 0.0;
+            for (uint32_t p = 0; p < plane_count; p++) {
+                const double* x = task->view.planes[p] + (base + task->offsets[k]) * width;
+                for (uint64_t t = 0; t < len * width; t++) sum += x[t] * x[t];
+            }
+            sums[k] += sum;
+        }
+    }
+}
+
+static void histogram_task(void* ctx, uint64_t begin, uint64_t end, uint32_t part) {
+    Measure_Task* task = ctx;
+    double sums[1u << MEASURE_CHUNK] = {0.0};
+    DISPATCH_LAYOUT(task->view, histogram_runs, task, begin, end, sums);
+    memcpy(task->histogram + (size_t)part * task->patterns, sums, task->patterns * sizeof(double));
+}
 
-    uint64_t qubit_mask = pow2(qubit);
+LAYOUT_INLINE void collapse_runs(const Measure_Task* task, uint64_t begin, uint64_t end,
+                                 uint32_t plane_count, uint32_t width) {
+    Walk_Cursor c = walk_start(&task->walk, begin, end);
+    uint64_t base, len;
+    while (walk_next(&task->walk, &c, &base, &len)) {
+        for (uint32_t k = 0; k < task->patterns; k++) {
+            double scale = (k == task->keep) ? task->scale : 0.0;
+            for (uint32_t p = 0; p < plane_count; p++) {
+                double* x = task->view.planes[p] + (base + task->offsets[k]) * width;
+                for (uint64_t t = 0; t < len * width; t++) x[t] *= scale;
+            }
+        }
+    }
+}
 
-    // Calculate probability of measuring |0⟩ on target qubit
-    double prob_zero = 0.0;
-    for (uint64_t i = 0; i < qstate->state_size; i++) {
-        if (i & qubit_mask) continue; // Skip |1⟩ states
+static void collapse_task(void* ctx, uint64_t begin, uint64_t end, uint32_t part) {
+    (void)part;
+    Measure_Task* task = ctx;
+    DISPATCH_LAYOUT(task->view, collapse_runs, task, begin, end);
+}
 
-        double r = qstate->real_amplitudes[i];
-        double im = qstate->imag_amplitudes[i];
-        prob_zero += r*r + im*im;
+// A single qubit below bit 3 leaves runs of under 8 amplitudes, so it is
+// measured with plain contiguous sweeps over the whole index range instead
+#define LINEAR_MEASURE_BELOW 3
+
+LAYOUT_INLINE void linear_histogram_runs(const Measure_Task* task, uint64_t begin, uint64_t end,
+                                         double* sums, uint32_t plane_count, uint32_t width) {
+    uint32_t shift = (uint32_t)__builtin_ctzll(task->offsets[1]);
+    for (uint32_t p = 0; p < plane_count; p++) {
+        const double* x = task->view.planes[p];
+        for (uint64_t i = begin; i < end; i++) {
+            for (uint32_t w = 0; w < width; w++) {
+                double a = x[i * width + w];
+                sums[(i >> shift) & 1] += a * a;
+            }
+        }
     }
+}
 
-    // Random measurement outcome based on Born rule
-    double random = (double)rand() / RAND_MAX;
-    uint8_t outcome = (random < prob_zero) ? 0 : 1;
+static void linear_histogram_task(void* ctx, uint64_t begin, uint64_t end, uint32_t part) {
+    Measure_Task* task = ctx;
+    double sums[2] = {0.0, 0.0};
+    DISPATCH_LAYOUT(task->view, linear_histogram_runs, task, begin, end, sums);
+    memcpy(task->histogram + (size_t)part * 2, sums, sizeof(sums));
+}
 
-    // Collapse state: zero out amplitudes inconsistent with measurement
-    for (uint64_t i = 0; i < qstate->state_size; i++) {
-        uint8_t bit = (i & qubit_mask) ? 1 : 0;
-        if (bit != outcome) {
-            qstate->real_amplitudes[i] = 0.0;
-            qstate->imag_amplitudes[i] = 0.0;
+LAYOUT_INLINE void linear_collapse_runs(const Measure_Task* task, uint64_t begin, uint64_t end,
+                                        uint32_t plane_count, uint32_t width) {
+    uint32_t shift = (uint32_t)__builtin_ctzll(task->offsets[1]);
+    double scale[2] = {task->keep ? 0.0 : task->scale, task->keep ? task->scale : 0.0};
+    for (uint32_t p = 0; p < plane_count; p++) {
+        double* x = task->view.planes[p];
+        for (uint64_t i = begin; i < end; i++) {
+            for (uint32_t w = 0; w < width; w++) x[i * width + w] *= scale[(i >> shift) & 1];
         }
     }
+}
 
-    // Renormalize
-    normalize_statevector(qstate);
+static void linear_collapse_task(void* ctx, uint64_t begin, uint64_t end, uint32_t part) {
+    (void)part;
+    Measure_Task* task = ctx;
+    DISPATCH_LAYOUT(task->view, linear_collapse_runs, task, begin, end);
+}
+
+// Jointly measure count ≤ MEASURE_CHUNK distinct qubits (ascending);
+// returns the outcome pattern, bit j for qubits[j]
+static uint32_t measure_chunk(Quantum_Simulator_State* qstate, const uint8_t* qubits,
+                              uint32_t count) {
+    uint32_t patterns = 1u << count;
+    uint64_t offsets[1u << MEASURE_CHUNK];
+    uint64_t mask = 0;
+    for (uint32_t j = 0; j < count; j++) mask |= pow2(qubits[j]);
+    for (uint32_t k = 0; k < patterns; k++) {
+        offsets[k] = 0;
+        for (uint32_t j = 0; j < count; j++) {
+            if ((k >> j) & 1) offsets[k] |= pow2(qubits[j]);
+        }
+    }
+
+    Measure_Task task = {amp_view(qstate), index_walk(qstate, mask), offsets, patterns, NULL, 0,
+                         0.0};
+    bool linear = count == 1 && qubits[0] < LINEAR_MEASURE_BELOW;
+    double prob[1u << MEASURE_CHUNK];
+    double total = 0.0;
+    if (count == 1 && ((qstate->marginal_valid >> qubits[0]) & 1)) {
+        // A cached marginal replaces pass 1
+        prob[1] = qstate->marginals[qubits[0]];
+        prob[0] = qstate->marginal_total - prob[1];
+        if (prob[0] < 0.0) prob[0] = 0.0;
+        total = prob[0] + prob[1];
+    } else {
+        // One histogram row per part; small ones fit on the stack
+        double stack_rows[4 * SIM_MAX_THREADS];
+        size_t cells = (size_t)qstate->threads * patterns;
+        double* histogram = (cells <= 4 * SIM_MAX_THREADS) ? stack_rows
+                                                           : malloc(cells * sizeof(double));
+        if (!histogram) return 0;
+        memset(histogram, 0, cells * sizeof(double));
+
+        task.histogram = histogram;
+        if (linear) parallel_run(qstate->threads, qstate->state_size, linear_histogram_task, &task);
+        else parallel_run(qstate->threads, task.walk.items, histogram_task, &task);
+
+        for (uint32_t k = 0; k < patterns; k++) {
+            prob[k] = 0.0;
+            for (uint32_t part = 0; part < qstate->threads; part++) {
+                prob[k] += histogram[(size_t)part * patterns + k];
+            }
+            total += prob[k];
+        }
+        if (histogram != stack_rows) free(histogram);
+    }
 
+    if (total < 1e-10) {
+        // Degenerate state - reinitialize to |0⟩
+        normalize_statevector(qstate);
+        return 0;
+    }
+
+    // Random measurement outcome based on Born rule (relative to the
+    // actual norm, so drift from 1 does not bias it); never a pattern
+    // with zero probability
+    double random = (double)rand() / RAND_MAX * total;
+    uint32_t outcome = 0;
+    double cumulative = 0.0;
+    for (uint32_t k = 0; k < patterns; k++) {
+        if (prob[k] == 0.0) continue;
+        outcome = k;
+        cumulative += prob[k];
+        if (random < cumulative) break;
+    }
+
+    // A state that already has the outcome with certainty, at unit norm,
+    // is its own post-measurement state
+    if (prob[outcome] == total && fabs(total - 1.0) < 1e-12) return outcome;
+
+    // Collapse and renormalize: the survivors' norm is prob[outcome]
+    task.keep = outcome;
+    task.scale = 1.0 / sqrt(prob[outcome]);
+    if (linear) parallel_run(qstate->threads, qstate->state_size, linear_collapse_task, &task);
+    else parallel_run(qstate->threads, task.walk.items, collapse_task, &task);
+
+    // Only the measured qubits are known afterwards
+    qstate->marginal_valid = mask;
+    qstate->marginal_total = 1.0;
+    qstate->blocks_valid = false;
+    for (uint32_t j = 0; j < count; j++) qstate->marginals[qubits[j]] = (outcome >> j) & 1;
     return outcome;
 }
 
+void quantum_simulator_measure_qubits(Qubit_State* state, const uint8_t* qubits, uint32_t count,
+                                      uint8_t* outcomes) {
+    apply_pending(state);
+    Quantum_Simulator_State* qstate = (Quantum_Simulator_State*)state->backend_data;
+
+    // Distinct qubits in ascending order; repeats report the same outcome
+    uint64_t seen[4] = {0};
+    uint8_t distinct[256];
+    uint32_t distinct_count = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t q = qubits[i];
+        if ((seen[q >> 6] >> (q & 63)) & 1) continue;
+        seen[q >> 6] |= 1ULL << (q & 63);
+    }
+    for (uint32_t q = 0; q < 256; q++) {
+        if ((seen[q >> 6] >> (q & 63)) & 1) distinct[distinct_count++] = (uint8_t)q;
+    }
+
+    // Chunks measured one after another sample the same joint distribution
+    uint8_t result[256];
+    for (uint32_t first = 0; first < distinct_count; first += MEASURE_CHUNK) {
+        uint32_t n = distinct_count - first;
+        if (n > MEASURE_CHUNK) n = MEASURE_CHUNK;
+        uint32_t pattern = measure_chunk(qstate, distinct + first, n);
+        for (uint32_t j = 0; j < n; j++) result[distinct[first + j]] = (pattern >> j) & 1;
+    }
+    for (uint32_t i = 0; i < count; i++) outcomes[i] = result[qubits[i]];
+}
+
+static uint8_t quantum_simulator_measure(Qubit_State* state, uint8_t qubit) {
+    apply_pending(state);
+
+    Quantum_Simulator_State* qstate =
+        (Quantum_Simulator_State*)state->backend_data;
+
+    return (uint8_t)measure_chunk(qstate, &qubit, 1);
+}
+
+// ============================================================================
+// Non-Collapsing Queries
+// ============================================================================
+// The cache is not part of the logical state, so it is refreshed (and the
+// gate queue flushed) through const handles.
+// ============================================================================
+
+static double quantum_simulator_probability(const Qubit_State* state, uint8_t qubit) {
+    Quantum_Simulator_State* qstate = (Quantum_Simulator_State*)state->backend_data;
+    if (qubit >= state->qubit_count) return 0.0;
+
+    if (!((qstate->marginal_valid >> qubit) & 1)) {
+        apply_pending((Qubit_State*)state);
+        if (!sweep_probabilities(qstate)) {
+            // No memory for the tables: two uncached sweeps for this qubit
+            double total = sum_probabilities(qstate, qstate->state_size);
+            double zero = sum_probabilities(qstate, pow2(qubit));
+            return total < 1e-10 ? 0.0 : 1.0 - zero / total;
+        }
+    }
+
+    double total = qstate->marginal_total;
+    if (total < 1e-10) return 0.0;
+    double p = qstate->marginals[qubit] / total;
+    return p < 0.0 ? 0.0 : (p > 1.0 ? 1.0 : p);
+}
+
 static uint8_t quantum_simulator_read(const Qubit_State* state, uint8_t qubit) {
-    // For quantum simulator: read performs measurement (cannot read without collapse)
-    // Note: This violates const, but that's the nature of quantum measurement
-    return quantum_simulator_measure((Qubit_State*)state, qubit);
+    // The more likely outcome; basis states read exactly as measured
+    return quantum_simulator_probability(state, qubit) > 0.5;
+}
+
+// Uniform in [0, 1) with 2^-62 resolution, so the smallest amplitudes of
+// a large state are still reachable
+static double random_unit(void) {
+    double scale = (double)RAND_MAX + 1.0;
+    return ((double)rand() * scale + (double)rand()) / (scale * scale);
+}
+
+// Index of the basis state at cumulative probability u (0 ≤ u < total),
+// never one with zero probability
+static uint64_t sample_index(const Quantum_Simulator_State* qstate, double u) {
+    uint64_t block = prob_block(qstate);
+    const double* cumulative = qstate->block_cumulative;
+    uint64_t lo = 0, hi = qstate->state_size / block - 1;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (cumulative[mid] > u) hi = mid;
+        else lo = mid + 1;
+    }
+    // Rounding can leave u at the very top: back off to a non-empty block
+    while (lo > 0 && cumulative[lo] == cumulative[lo - 1]) lo--;
+
+    double left = u - (lo ? cumulative[lo - 1] : 0.0);
+    uint64_t chosen = lo * block;
+    for (uint64_t i = lo * block; i < (lo + 1) * block; i++) {
+        double re, im;
+        load_amplitude(qstate, i, &re, &im);
+        double p = re * re + im * im;
+        if (p == 0.0) continue;
+        chosen = i;
+        if (left < p) break;
+        left -= p;
+    }
+    return chosen;
+}
+
+bool quantum_simulator_sample(Qubit_State* state, const uint8_t* qubits, uint32_t count,
+                              uint32_t shots, uint64_t* results) {
+    Quantum_Simulator_State* qstate = (Quantum_Simulator_State*)state->backend_data;
+    if (count > 64) count = 64;
+
+    // A single qubit with a cached marginal needs no table at all
+    if (count == 1 && qubits[0] < state->qubit_count &&
+        ((qstate->marginal_valid >> qubits[0]) & 1)) {
+        double p = quantum_simulator_probability(state, qubits[0]);
+        for (uint32_t s = 0; s < shots; s++) results[s] = random_unit() < p;
+        return true;
+    }
+
+    if (!qstate->blocks_valid) {
+        apply_pending(state);
+        if (!sweep_probabilities(qstate)) return false;
+    }
+
+    double total = qstate->block_cumulative[qstate->state_size / prob_block(qstate) - 1];
+    for (uint32_t s = 0; s < shots; s++) {
+        uint64_t index = (total < 1e-10) ? 0 : sample_index(qstate, random_unit() * total);
+        uint64_t bits = 0;
+        for (uint32_t j = 0; j < count; j++) {
+            if (qubits[j] < state->qubit_count) bits |= ((index >> qubits[j]) & 1) << j;
+        }
+        results[s] = bits;
+    }
+    return true;
 }
 
 // ============================================================================
@@ -326,12 +1342,14 @@ const Qubit_Backend_Ops quantum_simulator_ops = {
     .init = quantum_simulator_init,
     .free = quantum_simulator_free,
     .clone = quantum_simulator_clone,
+    .copy = quantum_simulator_copy,
     .CCNOT = quantum_simulator_CCNOT,
     .CNOT = quantum_simulator_CNOT,
     .NOT = quantum_simulator_NOT,
     .SWAP = quantum_simulator_SWAP,
     .measure = quantum_simulator_measure,
     .read = quantum_simulator_read,
+    .probability = quantum_simulator_probability,
     .name = quantum_simulator_name,
     .is_quantum = quantum_simulator_is_quantum
 };
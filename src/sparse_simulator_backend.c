@@ -0,0 +1,354 @@
+// sparse_simulator_backend.c
+// Sparse statevector simulator: only nonzero amplitudes are stored, as
+// (basis index, amplitude) entries in parallel arrays. The four gates
+// permute basis states, so a gate rewrites every stored index in place:
+// distinct indices stay distinct, nothing is inserted or moved, and the
+// cost is the number of terms rather than 2^n. Lookups by index go
+// through an open-addressed table that gates invalidate and the next
+// lookup rebuilds.
+
+#define _POSIX_C_SOURCE 200809L
+#include "moop_quantum_ready.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#ifdef ENABLE_QUANTUM_SIMULATOR
+
+#define NO_ENTRY UINT32_MAX
+
+static inline Sparse_Qubit_State* sparse_of(const Qubit_State* state) {
+    return (Sparse_Qubit_State*)state->backend_data;
+}
+
+// ============================================================================
+// Entry Storage
+// ============================================================================
+
+static bool reserve_entries(Sparse_Qubit_State* s, uint32_t needed) {
+    if (needed <= s->capacity) return true;
+    uint32_t capacity = s->capacity ? s->capacity : 16;
+    while (capacity < needed) capacity *= 2;
+
+    uint64_t* indices = realloc(s->indices, (size_t)capacity * sizeof(uint64_t));
+    if (indices) s->indices = indices;
+    double* real = realloc(s->real, (size_t)capacity * sizeof(double));
+    if (real) s->real = real;
+    double* imag = realloc(s->imag, (size_t)capacity * sizeof(double));
+    if (imag) s->imag = imag;
+    if (!indices || !real || !imag) return false;
+
+    s->capacity = capacity;
+    return true;
+}
+
+static inline uint32_t slot_hash(uint64_t index, uint32_t bits) {
+    return (uint32_t)((index * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+}
+
+static void insert_slot(Sparse_Qubit_State* s, uint32_t entry) {
+    uint32_t mask = (1u << s->slot_bits) - 1;
+    uint32_t slot = slot_hash(s->indices[entry], s->slot_bits);
+    while (s->slots[slot]) slot = (slot + 1) & mask;
+    s->slots[slot] = entry + 1;
+}
+
+// Table at most half full; false if it cannot be allocated
+static bool rebuild_slots(Sparse_Qubit_State* s) {
+    uint32_t bits = 4;
+    while ((1ull << bits) < 2ull * s->count) bits++;
+    if (bits != s->slot_bits || !s->slots) {
+        uint32_t* slots = realloc(s->slots, ((size_t)1 << bits) * sizeof(uint32_t));
+        if (!slots) return false;
+        s->slots = slots;
+        s->slot_bits = bits;
+    }
+    memset(s->slots, 0, ((size_t)1 << bits) * sizeof(uint32_t));
+    for (uint32_t e = 0; e < s->count; e++) insert_slot(s, e);
+    s->slots_valid = true;
+    return true;
+}
+
+static uint32_t find_entry(Sparse_Qubit_State* s, uint64_t index) {
+    if (!s->slots_valid && !rebuild_slots(s)) {
+        for (uint32_t e = 0; e < s->count; e++) {
+            if (s->indices[e] == index) return e;
+        }
+        return NO_ENTRY;
+    }
+
+    uint32_t mask = (1u << s->slot_bits) - 1;
+    for (uint32_t slot = slot_hash(index, s->slot_bits); s->slots[slot]; slot = (slot + 1) & mask) {
+        uint32_t e = s->slots[slot] - 1;
+        if (s->indices[e] == index) return e;
+    }
+    return NO_ENTRY;
+}
+
+static void reset_to_zero(Sparse_Qubit_State* s) {
+    s->indices[0] = 0;
+    s->real[0] = 1.0;
+    s->imag[0] = 0.0;
+    s->count = 1;
+    s->slots_valid = false;
+}
+
+// ============================================================================
+// Lifecycle Functions
+// ============================================================================
+
+static void sparse_free(Qubit_State* state) {
+    if (!state) return;
+
+    Sparse_Qubit_State* s = sparse_of(state);
+    if (s) {
+        free(s->indices);
+        free(s->real);
+        free(s->imag);
+        free(s->slots);
+        free(s);
+    }
+
+    free(state);
+}
+
+static Qubit_State* sparse_init(uint32_t n_qubits) {
+    if (n_qubits > SPARSE_MAX_QUBITS) {
+        fprintf(stderr, "Error: sparse simulator supports at most %d qubits (got %u)\n",
+                SPARSE_MAX_QUBITS, n_qubits);
+        return NULL;
+    }
+
+    Qubit_State* state = malloc(sizeof(Qubit_State));
+    if (!state) return NULL;
+
+    state->backend_type = QUBIT_BACKEND_SPARSE;
+    state->ops = &sparse_simulator_ops;
+    state->qubit_count = n_qubits;
+    state->metadata = NULL;
+
+    Sparse_Qubit_State* s = calloc(1, sizeof(Sparse_Qubit_State));
+    state->backend_data = s;
+    if (!s || !reserve_entries(s, 16)) {
+        sparse_free(state);
+        return NULL;
+    }
+
+    // Initialize to |0...0⟩ state
+    reset_to_zero(s);
+    return state;
+}
+
+// Unlike the dense backends, dst may have to grow to hold src's terms
+static void sparse_copy(Qubit_State* dst_state, const Qubit_State* src_state) {
+    const Sparse_Qubit_State* src = sparse_of(src_state);
+    Sparse_Qubit_State* dst = sparse_of(dst_state);
+    if (!reserve_entries(dst, src->count)) {
+        fprintf(stderr, "Error: sparse copy of %u terms failed, destination unchanged\n",
+                src->count);
+        return;
+    }
+
+    memcpy(dst->indices, src->indices, src->count * sizeof(uint64_t));
+    memcpy(dst->real, src->real, src->count * sizeof(double));
+    memcpy(dst->imag, src->imag, src->count * sizeof(double));
+    dst->count = src->count;
+    dst->slots_valid = false;
+}
+
+static Qubit_State* sparse_clone(const Qubit_State* state) {
+    if (!state) return NULL;
+
+    Qubit_State* cloned = sparse_init(state->qubit_count);
+    if (!cloned) return NULL;
+    if (!reserve_entries(sparse_of(cloned), sparse_of(state)->count)) {
+        sparse_free(cloned);
+        return NULL;
+    }
+    sparse_copy(cloned, state);
+    return cloned;
+}
+
+// ============================================================================
+// Quantum Gate Implementations (Index Rewrites)
+// ============================================================================
+// Gates with a repeated operand other than CCNOT's two controls leave the
+// state unchanged, as on the statevector simulator.
+// ============================================================================
+
+static void sparse_NOT(Qubit_State* state, uint8_t target) {
+    Sparse_Qubit_State* s = sparse_of(state);
+    uint64_t flip = 1ULL << target;
+    for (uint32_t e = 0; e < s->count; e++) s->indices[e] ^= flip;
+    s->slots_valid = false;
+}
+
+static void sparse_CNOT(Qubit_State* state, uint8_t control, uint8_t target) {
+    if (control == target) return;
+    Sparse_Qubit_State* s = sparse_of(state);
+    for (uint32_t e = 0; e < s->count; e++) {
+        uint64_t i = s->indices[e];
+        s->indices[e] = i ^ (((i >> control) & 1) << target);
+    }
+    s->slots_valid = false;
+}
+
+static void sparse_CCNOT(Qubit_State* state, uint8_t ctrl1, uint8_t ctrl2, uint8_t target) {
+    if (target == ctrl1 || target == ctrl2) return;
+    Sparse_Qubit_State* s = sparse_of(state);
+    for (uint32_t e = 0; e < s->count; e++) {
+        uint64_t i = s->indices[e];
+        s->indices[e] = i ^ (((i >> ctrl1) & (i >> ctrl2) & 1) << target);
+    }
+    s->slots_valid = false;
+}
+
+static void sparse_SWAP(Qubit_State* state, uint8_t qubit1, uint8_t qubit2) {
+    if (qubit1 == qubit2) return;
+    Sparse_Qubit_State* s = sparse_of(state);
+    for (uint32_t e = 0; e < s->count; e++) {
+        uint64_t i = s->indices[e];
+        uint64_t differ = ((i >> qubit1) ^ (i >> qubit2)) & 1;
+        s->indices[e] = i ^ ((differ << qubit1) | (differ << qubit2));
+    }
+    s->slots_valid = false;
+}
+
+// ============================================================================
+// Amplitude Access
+// ============================================================================
+
+void sparse_simulator_get_amplitude(Qubit_State* state, uint64_t index, double* re, double* im) {
+    Sparse_Qubit_State* s = sparse_of(state);
+    uint32_t e = find_entry(s, index);
+    *re = (e == NO_ENTRY) ? 0.0 : s->real[e];
+    *im = (e == NO_ENTRY) ? 0.0 : s->imag[e];
+}
+
+bool sparse_simulator_set_amplitude(Qubit_State* state, uint64_t index, double re, double im) {
+    Sparse_Qubit_State* s = sparse_of(state);
+    uint32_t e = find_entry(s, index);
+
+    if (re == 0.0 && im == 0.0) {
+        if (e == NO_ENTRY) return true;
+        // The last entry fills the hole
+        s->count--;
+        s->indices[e] = s->indices[s->count];
+        s->real[e] = s->real[s->count];
+        s->imag[e] = s->imag[s->count];
+        s->slots_valid = false;
+        return true;
+    }
+
+    if (e == NO_ENTRY) {
+        if (!reserve_entries(s, s->count + 1)) return false;
+        e = s->count++;
+        s->indices[e] = index;
+        if (s->slots_valid) {
+            if (2ull * s->count > (1ull << s->slot_bits)) s->slots_valid = false;
+            else insert_slot(s, e);
+        }
+    }
+    s->real[e] = re;
+    s->imag[e] = im;
+    return true;
+}
+
+uint32_t sparse_simulator_count(const Qubit_State* state) {
+    return sparse_of(state)->count;
+}
+
+// ============================================================================
+// Measurement (Collapses Quantum State)
+// ============================================================================
+
+// Σ|α|² of the terms with the qubit clear and set
+static void sparse_split(const Sparse_Qubit_State* s, uint8_t qubit, double* zero, double* one) {
+    double sums[2] = {0.0, 0.0};
+    for (uint32_t e = 0; e < s->count; e++) {
+        sums[(s->indices[e] >> qubit) & 1] += s->real[e] * s->real[e] + s->imag[e] * s->imag[e];
+    }
+    *zero = sums[0];
+    *one = sums[1];
+}
+
+static uint8_t sparse_measure(Qubit_State* state, uint8_t qubit) {
+    Sparse_Qubit_State* s = sparse_of(state);
+    double prob[2];
+    sparse_split(s, qubit, &prob[0], &prob[1]);
+    double total = prob[0] + prob[1];
+
+    if (total < 1e-10) {
+        // Degenerate state - reinitialize to |0⟩
+        reset_to_zero(s);
+        return 0;
+    }
+
+    // Born rule relative to the actual norm; never a zero-probability outcome
+    double random = (double)rand() / RAND_MAX * total;
+    uint8_t outcome = (prob[0] == 0.0 || (prob[1] != 0.0 && random >= prob[0])) ? 1 : 0;
+
+    // Already certain at unit norm: nothing to collapse
+    if (prob[outcome ^ 1] == 0.0 && fabs(total - 1.0) < 1e-12) return outcome;
+
+    // Keep the surviving terms, renormalized
+    double scale = 1.0 / sqrt(prob[outcome]);
+    uint32_t kept = 0;
+    for (uint32_t e = 0; e < s->count; e++) {
+        if (((s->indices[e] >> qubit) & 1) != outcome) continue;
+        s->indices[kept] = s->indices[e];
+        s->real[kept] = s->real[e] * scale;
+        s->imag[kept] = s->imag[e] * scale;
+        kept++;
+    }
+    s->count = kept;
+    s->slots_valid = false;
+    return outcome;
+}
+
+static double sparse_probability(const Qubit_State* state, uint8_t qubit) {
+    double zero, one;
+    sparse_split(sparse_of(state), qubit, &zero, &one);
+    double total = zero + one;
+    return total < 1e-10 ? 0.0 : one / total;
+}
+
+static uint8_t sparse_read(const Qubit_State* state, uint8_t qubit) {
+    // The more likely outcome, without collapsing (as on the dense simulator)
+    return sparse_probability(state, qubit) > 0.5;
+}
+
+// ============================================================================
+// Backend Info
+// ============================================================================
+
+static const char* sparse_name(void) {
+    return "Quantum Simulator (Sparse)";
+}
+
+static bool sparse_is_quantum(void) {
+    return true;
+}
+
+// ============================================================================
+// Operations Table
+// ============================================================================
+
+const Qubit_Backend_Ops sparse_simulator_ops = {
+    .init = sparse_init,
+    .free = sparse_free,
+    .clone = sparse_clone,
+    .copy = sparse_copy,
+    .CCNOT = sparse_CCNOT,
+    .CNOT = sparse_CNOT,
+    .NOT = sparse_NOT,
+    .SWAP = sparse_SWAP,
+    .measure = sparse_measure,
+    .read = sparse_read,
+    .probability = sparse_probability,
+    .name = sparse_name,
+    .is_quantum = sparse_is_quantum
+};
+
+#endif // ENABLE_QUANTUM_SIMULATOR
@@ -0,0 +1,185 @@
+// tape_interp.c
+// Direct-threaded interpreter for stored gate programs
+// Cells are decoded once into 8-byte instructions holding their handler's
+// offset from the interpreter's base label, so each gate ends in its own
+// indirect jump to the next (GCC/Clang computed goto) instead of looping
+// back through one shared switch
+
+#define _POSIX_C_SOURCE 200809L
+#include "moop_enhanced.h"
+#include <stdlib.h>
+
+// Handler index: backend family * 5 + gate (4: dissipative), then END
+enum {
+    OP_CLASSICAL = 0,
+    OP_PACKED = 5,
+    OP_GENERIC = 10,
+    OP_END = 15
+};
+
+#define HANDLER(label) (int32_t)(&&label - &&classical_ccnot)
+
+// Label offsets are only valid in the one copy of interp that took them,
+// so it must not be inlined or (GCC) cloned for the interp(NULL, NULL) call
+#ifdef __clang__
+#define INTERP_SINGLE_COPY __attribute__((noinline))
+#else
+#define INTERP_SINGLE_COPY __attribute__((noinline, noclone))
+#endif
+
+// Runs p on s. With s == NULL, returns the handler offsets instead: labels
+// only exist inside this function, so compile threads through it
+INTERP_SINGLE_COPY
+static const int32_t* interp(const L2a_Program* p, Qubit_State* s) {
+    static const int32_t handlers[] = {
+        HANDLER(classical_ccnot), HANDLER(classical_cnot),
+        HANDLER(classical_not), HANDLER(classical_swap), HANDLER(classical_dissipate),
+        HANDLER(packed_ccnot), HANDLER(packed_cnot),
+        HANDLER(packed_not), HANDLER(packed_swap), HANDLER(packed_dissipate),
+        HANDLER(generic_ccnot), HANDLER(generic_cnot),
+        HANDLER(generic_not), HANDLER(generic_swap), HANDLER(generic_dissipate),
+        HANDLER(end)
+    };
+    if (!s) return handlers;
+
+    const L2a_Instr* ip = p->code;
+    uint8_t* bits = NULL;
+    uint64_t* words = NULL;
+    const Qubit_Backend_Ops* ops = s->ops;
+    if (p->backend == QUBIT_BACKEND_CLASSICAL) bits = QUBIT_CLASSICAL_BITS(s);
+    if (p->backend == QUBIT_BACKEND_PACKED) words = QUBIT_PACKED_WORDS(s);
+
+    const char* base = (const char*)&&classical_ccnot;
+#define NEXT() goto *(base + (++ip)->handler)
+    goto *(base + ip->handler);
+
+    // Handlers are the shared inline kernels on pre-resolved storage
+classical_ccnot:
+    classical_bits_CCNOT(bits, ip->a, ip->b, ip->c);
+    NEXT();
+classical_cnot:
+    classical_bits_CNOT(bits, ip->a, ip->b);
+    NEXT();
+classical_not:
+    classical_bits_NOT(bits, ip->a);
+    NEXT();
+classical_swap:
+    classical_bits_SWAP(bits, ip->a, ip->b);
+    NEXT();
+classical_dissipate:
+    classical_bits_SET(bits, ip->c, l2b_op_eval(ip->op, bits[ip->a], bits[ip->b]));
+    NEXT();
+
+packed_ccnot:
+    packed_words_CCNOT(words, ip->a, ip->b, ip->c);
+    NEXT();
+packed_cnot:
+    packed_words_CNOT(words, ip->a, ip->b);
+    NEXT();
+packed_not:
+    packed_words_NOT(words, ip->a);
+    NEXT();
+packed_swap:
+    packed_words_SWAP(words, ip->a, ip->b);
+    NEXT();
+packed_dissipate:
+    packed_words_SET(words, ip->c, l2b_op_eval(ip->op, (uint8_t)packed_words_get(words, ip->a),
+                                               (uint8_t)packed_words_get(words, ip->b)));
+    NEXT();
+
+    // Other backends: one call through the cached ops table per gate
+generic_ccnot:
+    ops->CCNOT(s, ip->a, ip->b, ip->c);
+    NEXT();
+generic_cnot:
+    ops->CNOT(s, ip->a, ip->b);
+    NEXT();
+generic_not:
+    ops->NOT(s, ip->a);
+    NEXT();
+generic_swap:
+    ops->SWAP(s, ip->a, ip->b);
+    NEXT();
+generic_dissipate:
+    if (ops->read(s, ip->c) != l2b_op_eval(ip->op, ops->read(s, ip->a), ops->read(s, ip->b))) {
+        ops->NOT(s, ip->c);
+    }
+    NEXT();
+
+#undef NEXT
+#undef HANDLER
+end:
+    return NULL;
+}
+
+static inline void mark_written(L2a_Program* p, uint8_t q) {
+    p->written[q >> 6] |= 1ULL << (q & 63);
+}
+
+L2a_Program* l2a_program_compile(const R_Cell* cells, uint32_t n, Qubit_Backend_Type backend) {
+    L2a_Program* p = calloc(1, sizeof(L2a_Program));
+    if (!p) return NULL;
+    p->code = malloc(((size_t)n + 1) * sizeof(L2a_Instr));
+    if (!p->code) {
+        free(p);
+        return NULL;
+    }
+    p->backend = backend;
+
+    uint32_t family = (backend == QUBIT_BACKEND_CLASSICAL) ? OP_CLASSICAL :
+                      (backend == QUBIT_BACKEND_PACKED) ? OP_PACKED : OP_GENERIC;
+    const int32_t* handlers = interp(NULL, NULL);
+
+    for (uint32_t i = 0; i < n; i++) {
+        R_Cell c = cells[i];
+        if (l2a_is_dissipative(c.gate)) {
+            uint8_t op = (c.gate & 0x0F) >> 1;
+            p->code[p->length++] = (L2a_Instr){handlers[family + 4], c.a, c.b, c.c, op};
+            mark_written(p, c.c);
+            continue;
+        }
+        if (c.gate > 3) continue;  // Not a gate (replay ignores it too)
+
+        p->code[p->length++] = (L2a_Instr){handlers[family + c.gate], c.a, c.b, c.c, 0};
+
+        switch (c.gate) {
+            case 0: mark_written(p, c.c); break;
+            case 1: mark_written(p, c.b); break;
+            case 2: mark_written(p, c.a); break;
+            case 3: mark_written(p, c.a); mark_written(p, c.b); break;
+        }
+    }
+    p->code[p->length] = (L2a_Instr){.handler = handlers[OP_END]};
+
+    return p;
+}
+
+L2a_Program* l2a_program_from_tape(const L2a_Runtime* r, uint32_t from, uint32_t to) {
+    // Only the last tape length of history is still recorded
+    if (to > r->total_ops) to = r->total_ops;
+    uint32_t oldest = (r->total_ops > r->tape.size) ? r->total_ops - r->tape.size : 0;
+    if (from < oldest) from = oldest;
+    uint32_t n = (from < to) ? to - from : 0;
+
+    R_Cell* cells = malloc(((size_t)n + 1) * sizeof(R_Cell));
+    if (!cells) return NULL;
+    for (uint32_t i = 0; i < n; i++) {
+        cells[i] = r->tape.cells[(from + i) & r->tape.mask];
+    }
+
+    L2a_Program* p = l2a_program_compile(cells, n, r->qubit_state->backend_type);
+    free(cells);
+    return p;
+}
+
+bool l2a_program_run(const L2a_Program* p, Qubit_State* state) {
+    if (!p || !state || state->backend_type != p->backend) return false;
+    interp(p, state);
+    return true;
+}
+
+void l2a_program_free(L2a_Program* p) {
+    if (!p) return;
+    free(p->code);
+    free(p);
+}
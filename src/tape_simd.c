@@ -0,0 +1,448 @@
+// tape_simd.c
+// Vectorized L2a tape kernels with runtime dispatch
+// Fitness kernels keep the scalar operation order and use IEEE division,
+// so every variant writes bit-identical fitness; only the stats sum is
+// reassociated across lanes
+
+#define _POSIX_C_SOURCE 200809L
+#include "tape_simd.h"
+#include <stdatomic.h>
+
+// The NEON kernels have not been run on AArch64 hardware yet, so they are
+// opt-in (-DMOOP_ENABLE_NEON) until verified; the default there is scalar
+#if defined(__x86_64__)
+#define TAPE_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(MOOP_ENABLE_NEON)
+#define TAPE_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// ============================================================================
+// Scalar Kernels (reference + fallback)
+// ============================================================================
+
+static void scalar_fitness_stats(const float* fitness, uint32_t n,
+                                 float* min, float* max, float* sum) {
+    float lo = *min, hi = *max, total = 0.0f;
+
+    for (uint32_t i = 0; i < n; i++) {
+        total += fitness[i];
+        lo = (fitness[i] < lo) ? fitness[i] : lo;
+        hi = (fitness[i] > hi) ? fitness[i] : hi;
+    }
+
+    *min = lo;
+    *max = hi;
+    *sum = total;
+}
+
+static uint32_t scalar_active_count(const R_Cell* cells, uint32_t n) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        count += (cells[i].gate | cells[i].a) != 0;
+    }
+    return count;
+}
+
+static uint32_t scalar_essential_count(const uint64_t* bitmap, uint32_t words) {
+    uint32_t count = 0;
+    for (uint32_t w = 0; w < words; w++) {
+        count += (uint32_t)__builtin_popcountll(bitmap[w]);
+    }
+    return count;
+}
+
+static inline bool is_essential(const L2a_Tape* t, uint32_t i) {
+    return (t->essential[i >> 6] >> (i & 63)) & 1;
+}
+
+static void scalar_fitness_range(L2a_Tape* t, uint32_t begin, uint32_t end,
+                                 uint32_t total_ops, const Fitness_Params* p) {
+    for (uint32_t i = begin; i < end; i++) {
+        if (is_essential(t, i)) continue;
+        t->fitness[i] = p->recency_weight * tape_recency(total_ops - t->last_used[i]) +
+                        p->activity_weight * t->activity[i] +
+                        p->gate_weight * tape_gate_priority(t->cells[i].gate);
+    }
+}
+
+static void scalar_batch_fitness(L2a_Tape* t, uint32_t n, uint32_t total_ops,
+                                 const Fitness_Params* p) {
+    scalar_fitness_range(t, 0, n, total_ops, p);
+}
+
+const Tape_Kernels tape_kernels_scalar = {
+    .fitness_stats = scalar_fitness_stats,
+    .active_count = scalar_active_count,
+    .essential_count = scalar_essential_count,
+    .batch_fitness = scalar_batch_fitness,
+    .name = "scalar"
+};
+
+#ifdef TAPE_SIMD_X86
+
+// ============================================================================
+// SSE2 Kernels (x86-64 baseline)
+// ============================================================================
+
+static void sse2_fitness_stats(const float* fitness, uint32_t n,
+                               float* min, float* max, float* sum) {
+    __m128 lo = _mm_set1_ps(*min), hi = _mm_set1_ps(*max);
+    __m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps();
+    uint32_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m128 a = _mm_loadu_ps(fitness + i);
+        __m128 b = _mm_loadu_ps(fitness + i + 4);
+        s0 = _mm_add_ps(s0, a);
+        s1 = _mm_add_ps(s1, b);
+        lo = _mm_min_ps(lo, _mm_min_ps(a, b));
+        hi = _mm_max_ps(hi, _mm_max_ps(a, b));
+    }
+
+    float l[4], h[4], s[4];
+    _mm_storeu_ps(l, lo);
+    _mm_storeu_ps(h, hi);
+    _mm_storeu_ps(s, _mm_add_ps(s0, s1));
+
+    float tail_sum;
+    *min = l[0];
+    *max = h[0];
+    for (int k = 1; k < 4; k++) {
+        *min = (l[k] < *min) ? l[k] : *min;
+        *max = (h[k] > *max) ? h[k] : *max;
+    }
+    scalar_fitness_stats(fitness + i, n - i, min, max, &tail_sum);
+    *sum = (s[0] + s[1]) + (s[2] + s[3]) + tail_sum;
+}
+
+static uint32_t sse2_active_count(const R_Cell* cells, uint32_t n) {
+    // Little-endian: gate and a are the low 16 bits of each 32-bit cell
+    const __m128i low16 = _mm_set1_epi32(0xFFFF);
+    __m128i idle = _mm_setzero_si128();
+    uint32_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i w = _mm_and_si128(_mm_loadu_si128((const __m128i*)(cells + i)), low16);
+        idle = _mm_sub_epi32(idle, _mm_cmpeq_epi32(w, _mm_setzero_si128()));
+    }
+
+    uint32_t lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, idle);
+    return i - (lanes[0] + lanes[1] + lanes[2] + lanes[3]) + scalar_active_count(cells + i, n - i);
+}
+
+static inline __m128 sse2_gate_priority(__m128i gate) {
+    __m128 gp = _mm_setzero_ps();
+    for (int g = 0; g < 4; g++) {
+        __m128 hit = _mm_castsi128_ps(_mm_cmpeq_epi32(gate, _mm_set1_epi32(g)));
+        gp = _mm_or_ps(gp, _mm_and_ps(hit, _mm_set1_ps(tape_gate_priority((uint8_t)g))));
+    }
+    return gp;
+}
+
+static void sse2_batch_fitness(L2a_Tape* t, uint32_t n, uint32_t total_ops,
+                               const Fitness_Params* p) {
+    const __m128 wr = _mm_set1_ps(p->recency_weight);
+    const __m128 wa = _mm_set1_ps(p->activity_weight);
+    const __m128 wg = _mm_set1_ps(p->gate_weight);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 hundred = _mm_set1_ps(100.0f);
+    const __m128i total = _mm_set1_epi32((int)total_ops);
+    const __m128i gate_byte = _mm_set1_epi32(0xFF);
+    const __m128i lane_bits = _mm_setr_epi32(1, 2, 4, 8);
+
+    for (uint32_t i = 0; i < n; i += 4) {
+        uint32_t essential = (uint32_t)(t->essential[i >> 6] >> (i & 63)) & 0xF;
+        if (essential == 0xF) continue;
+
+        // Ages >= 2^31 would convert as negative; take the scalar path
+        __m128i age = _mm_sub_epi32(total, _mm_loadu_si128((const __m128i*)(t->last_used + i)));
+        if (_mm_movemask_ps(_mm_castsi128_ps(age))) {
+            scalar_fitness_range(t, i, i + 4, total_ops, p);
+            continue;
+        }
+
+        __m128 recency = _mm_div_ps(one, _mm_add_ps(one, _mm_div_ps(_mm_cvtepi32_ps(age), hundred)));
+        __m128i gate = _mm_and_si128(_mm_loadu_si128((const __m128i*)(t->cells + i)), gate_byte);
+        __m128 fit = _mm_add_ps(_mm_add_ps(_mm_mul_ps(wr, recency),
+                                           _mm_mul_ps(wa, _mm_loadu_ps(t->activity + i))),
+                                _mm_mul_ps(wg, sse2_gate_priority(gate)));
+
+        if (essential) {
+            __m128i sel = _mm_and_si128(_mm_set1_epi32((int)essential), lane_bits);
+            __m128 keep = _mm_castsi128_ps(_mm_cmpeq_epi32(sel, lane_bits));
+            fit = _mm_or_ps(_mm_and_ps(keep, _mm_loadu_ps(t->fitness + i)),
+                            _mm_andnot_ps(keep, fit));
+        }
+        _mm_storeu_ps(t->fitness + i, fit);
+    }
+}
+
+static const Tape_Kernels tape_kernels_sse2 = {
+    .fitness_stats = sse2_fitness_stats,
+    .active_count = sse2_active_count,
+    .essential_count = scalar_essential_count,
+    .batch_fitness = sse2_batch_fitness,
+    .name = "sse2"
+};
+
+// ============================================================================
+// AVX2 Kernels (runtime-selected)
+// ============================================================================
+
+#define AVX2_TARGET __attribute__((target("avx2,popcnt")))
+
+AVX2_TARGET static void avx2_fitness_stats(const float* fitness, uint32_t n,
+                                           float* min, float* max, float* sum) {
+    __m256 lo = _mm256_set1_ps(*min), hi = _mm256_set1_ps(*max);
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+    uint32_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m256 a = _mm256_loadu_ps(fitness + i);
+        __m256 b = _mm256_loadu_ps(fitness + i + 8);
+        s0 = _mm256_add_ps(s0, a);
+        s1 = _mm256_add_ps(s1, b);
+        lo = _mm256_min_ps(lo, _mm256_min_ps(a, b));
+        hi = _mm256_max_ps(hi, _mm256_max_ps(a, b));
+    }
+
+    float l[8], h[8], s[8];
+    _mm256_storeu_ps(l, lo);
+    _mm256_storeu_ps(h, hi);
+    _mm256_storeu_ps(s, _mm256_add_ps(s0, s1));
+
+    float tail_sum;
+    *min = l[0];
+    *max = h[0];
+    for (int k = 1; k < 8; k++) {
+        *min = (l[k] < *min) ? l[k] : *min;
+        *max = (h[k] > *max) ? h[k] : *max;
+    }
+    scalar_fitness_stats(fitness + i, n - i, min, max, &tail_sum);
+    *sum = ((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7])) + tail_sum;
+}
+
+AVX2_TARGET static uint32_t avx2_active_count(const R_Cell* cells, uint32_t n) {
+    const __m256i low16 = _mm256_set1_epi32(0xFFFF);
+    __m256i idle = _mm256_setzero_si256();
+    uint32_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i w = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(cells + i)), low16);
+        idle = _mm256_sub_epi32(idle, _mm256_cmpeq_epi32(w, _mm256_setzero_si256()));
+    }
+
+    uint32_t lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, idle);
+    uint32_t idle_count = 0;
+    for (int k = 0; k < 8; k++) idle_count += lanes[k];
+    return i - idle_count + scalar_active_count(cells + i, n - i);
+}
+
+AVX2_TARGET static uint32_t avx2_essential_count(const uint64_t* bitmap, uint32_t words) {
+    // Same loop as scalar, but with the popcnt instruction available
+    uint32_t count = 0;
+    for (uint32_t w = 0; w < words; w++) {
+        count += (uint32_t)__builtin_popcountll(bitmap[w]);
+    }
+    return count;
+}
+
+AVX2_TARGET static void avx2_batch_fitness(L2a_Tape* t, uint32_t n, uint32_t total_ops,
+                                           const Fitness_Params* p) {
+    const __m256 wr = _mm256_set1_ps(p->recency_weight);
+    const __m256 wa = _mm256_set1_ps(p->activity_weight);
+    const __m256 wg = _mm256_set1_ps(p->gate_weight);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 hundred = _mm256_set1_ps(100.0f);
+    const __m256i total = _mm256_set1_epi32((int)total_ops);
+    const __m256i gate_byte = _mm256_set1_epi32(0xFF);
+    const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256 priority[4];
+    for (int g = 0; g < 4; g++) {
+        priority[g] = _mm256_set1_ps(tape_gate_priority((uint8_t)g));
+    }
+
+    for (uint32_t i = 0; i < n; i += 8) {
+        uint32_t essential = (uint32_t)(t->essential[i >> 6] >> (i & 63)) & 0xFF;
+        if (essential == 0xFF) continue;
+
+        // Ages >= 2^31 would convert as negative; take the scalar path
+        __m256i age = _mm256_sub_epi32(total, _mm256_loadu_si256((const __m256i*)(t->last_used + i)));
+        if (_mm256_movemask_ps(_mm256_castsi256_ps(age))) {
+            scalar_fitness_range(t, i, i + 8, total_ops, p);
+            continue;
+        }
+
+        __m256 recency = _mm256_div_ps(one, _mm256_add_ps(one, _mm256_div_ps(_mm256_cvtepi32_ps(age), hundred)));
+
+        __m256i gate = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(t->cells + i)), gate_byte);
+        __m256 gp = _mm256_setzero_ps();
+        for (int g = 0; g < 4; g++) {
+            __m256 hit = _mm256_castsi256_ps(_mm256_cmpeq_epi32(gate, _mm256_set1_epi32(g)));
+            gp = _mm256_or_ps(gp, _mm256_and_ps(hit, priority[g]));
+        }
+
+        __m256 fit = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(wr, recency),
+                                                 _mm256_mul_ps(wa, _mm256_loadu_ps(t->activity + i))),
+                                   _mm256_mul_ps(wg, gp));
+
+        if (essential) {
+            __m256i sel = _mm256_and_si256(_mm256_set1_epi32((int)essential), lane_bits);
+            __m256 keep = _mm256_castsi256_ps(_mm256_cmpeq_epi32(sel, lane_bits));
+            fit = _mm256_blendv_ps(fit, _mm256_loadu_ps(t->fitness + i), keep);
+        }
+        _mm256_storeu_ps(t->fitness + i, fit);
+    }
+}
+
+static const Tape_Kernels tape_kernels_avx2 = {
+    .fitness_stats = avx2_fitness_stats,
+    .active_count = avx2_active_count,
+    .essential_count = avx2_essential_count,
+    .batch_fitness = avx2_batch_fitness,
+    .name = "avx2"
+};
+
+#endif // TAPE_SIMD_X86
+
+#ifdef TAPE_SIMD_NEON
+
+// ============================================================================
+// NEON Kernels (AArch64 baseline)
+// ============================================================================
+
+static void neon_fitness_stats(const float* fitness, uint32_t n,
+                               float* min, float* max, float* sum) {
+    float32x4_t lo = vdupq_n_f32(*min), hi = vdupq_n_f32(*max);
+    float32x4_t s0 = vdupq_n_f32(0.0f), s1 = vdupq_n_f32(0.0f);
+    uint32_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        float32x4_t a = vld1q_f32(fitness + i);
+        float32x4_t b = vld1q_f32(fitness + i + 4);
+        s0 = vaddq_f32(s0, a);
+        s1 = vaddq_f32(s1, b);
+        lo = vminq_f32(lo, vminq_f32(a, b));
+        hi = vmaxq_f32(hi, vmaxq_f32(a, b));
+    }
+
+    float tail_sum;
+    *min = vminvq_f32(lo);
+    *max = vmaxvq_f32(hi);
+    scalar_fitness_stats(fitness + i, n - i, min, max, &tail_sum);
+    *sum = vaddvq_f32(vaddq_f32(s0, s1)) + tail_sum;
+}
+
+static uint32_t neon_active_count(const R_Cell* cells, uint32_t n) {
+    const uint32x4_t low16 = vdupq_n_u32(0xFFFF);
+    uint32x4_t active = vdupq_n_u32(0);
+    uint32_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        uint32x4_t w = vld1q_u32((const uint32_t*)(cells + i));
+        active = vsubq_u32(active, vtstq_u32(w, low16));
+    }
+
+    return vaddvq_u32(active) + scalar_active_count(cells + i, n - i);
+}
+
+static uint32_t neon_essential_count(const uint64_t* bitmap, uint32_t words) {
+    uint32_t count = 0;
+    uint32_t w = 0;
+
+    for (; w + 2 <= words; w += 2) {
+        count += vaddlvq_u8(vcntq_u8(vld1q_u8((const uint8_t*)(bitmap + w))));
+    }
+    return count + scalar_essential_count(bitmap + w, words - w);
+}
+
+static void neon_batch_fitness(L2a_Tape* t, uint32_t n, uint32_t total_ops,
+                               const Fitness_Params* p) {
+    const float32x4_t wr = vdupq_n_f32(p->recency_weight);
+    const float32x4_t wa = vdupq_n_f32(p->activity_weight);
+    const float32x4_t wg = vdupq_n_f32(p->gate_weight);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t hundred = vdupq_n_f32(100.0f);
+    const uint32x4_t total = vdupq_n_u32(total_ops);
+    const uint32x4_t gate_byte = vdupq_n_u32(0xFF);
+    const uint32_t bits[4] = {1, 2, 4, 8};
+    const uint32x4_t lane_bits = vld1q_u32(bits);
+
+    for (uint32_t i = 0; i < n; i += 4) {
+        uint32_t essential = (uint32_t)(t->essential[i >> 6] >> (i & 63)) & 0xF;
+        if (essential == 0xF) continue;
+
+        // NEON converts unsigned ages directly
+        uint32x4_t age = vsubq_u32(total, vld1q_u32(t->last_used + i));
+        float32x4_t recency = vdivq_f32(one, vaddq_f32(one, vdivq_f32(vcvtq_f32_u32(age), hundred)));
+
+        uint32x4_t gate = vandq_u32(vld1q_u32((const uint32_t*)(t->cells + i)), gate_byte);
+        float32x4_t gp = vdupq_n_f32(0.0f);
+        for (uint32_t g = 0; g < 4; g++) {
+            gp = vbslq_f32(vceqq_u32(gate, vdupq_n_u32(g)),
+                           vdupq_n_f32(tape_gate_priority((uint8_t)g)), gp);
+        }
+
+        float32x4_t fit = vaddq_f32(vaddq_f32(vmulq_f32(wr, recency),
+                                              vmulq_f32(wa, vld1q_f32(t->activity + i))),
+                                    vmulq_f32(wg, gp));
+
+        if (essential) {
+            uint32x4_t keep = vtstq_u32(vdupq_n_u32(essential), lane_bits);
+            fit = vbslq_f32(keep, vld1q_f32(t->fitness + i), fit);
+        }
+        vst1q_f32(t->fitness + i, fit);
+    }
+}
+
+static const Tape_Kernels tape_kernels_neon = {
+    .fitness_stats = neon_fitness_stats,
+    .active_count = neon_active_count,
+    .essential_count = neon_essential_count,
+    .batch_fitness = neon_batch_fitness,
+    .name = "neon"
+};
+
+#endif // TAPE_SIMD_NEON
+
+// ============================================================================
+// Runtime Dispatch
+// ============================================================================
+
+uint32_t tape_kernels_supported(const Tape_Kernels** out, uint32_t max) {
+    uint32_t count = 0;
+
+    if (count < max) out[count++] = &tape_kernels_scalar;
+#ifdef TAPE_SIMD_X86
+    if (count < max) out[count++] = &tape_kernels_sse2;
+    __builtin_cpu_init();
+    if (count < max && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+        out[count++] = &tape_kernels_avx2;
+    }
+#endif
+#ifdef TAPE_SIMD_NEON
+    if (count < max) out[count++] = &tape_kernels_neon;
+#endif
+
+    return count;
+}
+
+const Tape_Kernels* tape_kernels(void) {
+    // Resolved once; racing first calls all store the same pointer, through
+    // an atomic so the unsynchronized load is well defined
+    static _Atomic(const Tape_Kernels*) selected = NULL;
+
+    const Tape_Kernels* kernels = atomic_load_explicit(&selected, memory_order_acquire);
+    if (!kernels) {
+        const Tape_Kernels* variants[4];
+        uint32_t count = tape_kernels_supported(variants, 4);
+        kernels = variants[count - 1];
+        atomic_store_explicit(&selected, kernels, memory_order_release);
+    }
+
+    return kernels;
+}
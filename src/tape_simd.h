@@ -0,0 +1,56 @@
+// tape_simd.h
+// Vectorized L2a tape kernels (internal)
+// AVX2 / SSE2 on x86-64, NEON on AArch64 (opt-in: -DMOOP_ENABLE_NEON),
+// scalar elsewhere; the best variant is picked once at runtime from CPU
+// features
+
+#ifndef TAPE_SIMD_H
+#define TAPE_SIMD_H
+
+#include "moop_enhanced.h"
+
+// Scalar reference terms shared with l2a_compute_fitness
+static inline float tape_gate_priority(uint8_t gate) {
+    // CCNOT > CNOT > SWAP > NOT
+    switch (gate) {
+        case 0: return 0.4f;  // CCNOT (universal gate)
+        case 1: return 0.3f;  // CNOT
+        case 3: return 0.2f;  // SWAP
+        case 2: return 0.1f;  // NOT
+    }
+    return 0.0f;
+}
+
+static inline float tape_recency(uint32_t age) {
+    // 0.0-1.0, exponential decay
+    return (age == 0) ? 1.0f : (1.0f / (1.0f + age / 100.0f));
+}
+
+typedef struct {
+    // Fitness sum, and min/max folded into the values *min/*max hold on entry
+    void (*fitness_stats)(const float* fitness, uint32_t n,
+                          float* min, float* max, float* sum);
+
+    // Entries whose gate or first operand is non-zero
+    uint32_t (*active_count)(const R_Cell* cells, uint32_t n);
+
+    // Set bits in the essential bitmap
+    uint32_t (*essential_count)(const uint64_t* bitmap, uint32_t words);
+
+    // fitness[i] = weighted recency/activity/gate score for every
+    // non-essential entry (n must be a multiple of 64)
+    void (*batch_fitness)(L2a_Tape* tape, uint32_t n, uint32_t total_ops,
+                          const Fitness_Params* params);
+
+    const char* name;
+} Tape_Kernels;
+
+extern const Tape_Kernels tape_kernels_scalar;
+
+// Best kernels for this CPU (resolved on first call)
+const Tape_Kernels* tape_kernels(void);
+
+// Every variant this CPU can run, scalar first; returns the count
+uint32_t tape_kernels_supported(const Tape_Kernels** out, uint32_t max);
+
+#endif // TAPE_SIMD_H
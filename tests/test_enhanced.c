@@ -3,10 +3,22 @@
 
 #define _POSIX_C_SOURCE 200809L
 #include "../src/moop_enhanced.h"
+#include "../src/tape_simd.h"
+#include "../src/gate_jit.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include <math.h>
+#if defined(GATE_JIT_X86_64) && defined(__linux__)
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifndef PR_SET_MDWE
+#define PR_SET_MDWE 65
+#define PR_MDWE_REFUSE_EXEC_GAIN 1
+#endif
+#endif
 
 // ============================================================================
 // Feature 1: Tape-Loop Turing Machine (1024 circular cells)
@@ -31,7 +43,7 @@ void test_tape_loop() {
     assert(r->tape_wrapped == true);
 
     // Verify circular tape: head should wrap around
-    R_Cell last_cell = r->tape[5].cell;  // Position 5
+    R_Cell last_cell = r->tape.cells[5];  // Position 5
     assert(last_cell.gate == 2);  // NOT gate
     assert(last_cell.a == 0);
 
@@ -243,6 +255,951 @@ void test_integrated() {
     moop_free(moop);
 }
 
+// ============================================================================
+// Evolutionary Pruning (in-place selection)
+// ============================================================================
+
+void test_evolutionary_pruning() {
+    printf("\n=== Test 6: Evolutionary Pruning ===\n");
+
+    L2a_Runtime* r = l2a_init(8, 7, QUBIT_BACKEND_CLASSICAL);
+
+    // Fill the tape without automatic pruning
+    Fitness_Params params = l2a_get_fitness_params(r);
+    params.prune_interval = 1u << 30;
+    l2a_tune_fitness(r, params);
+
+    uint32_t seed = 7;
+    for (uint32_t i = 0; i < L1_TAPE_SIZE; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint8_t a = (seed >> 8) % 8, b = (seed >> 12) % 8, c = (seed >> 16) % 8;
+        switch ((seed >> 20) % 4) {
+            case 0: l2a_CCNOT(r, a, b, c); break;
+            case 1: l2a_CNOT(r, a, b); break;
+            case 2: l2a_NOT(r, a); break;
+            case 3: l2a_SWAP(r, a, b); break;
+        }
+    }
+    l2a_mark_essential(r, 900);
+
+    // Expected fitness and cells before pruning
+    static float fitness[L1_TAPE_SIZE];
+    static R_Cell cells[L1_TAPE_SIZE];
+    for (uint32_t i = 0; i < L1_TAPE_SIZE; i++) {
+        fitness[i] = l2a_compute_fitness(r, i);
+        cells[i] = r->tape.cells[i];
+    }
+
+    l2a_prune_tape(r);
+
+    // Kept entries stay at their positions; every reset entry ranks at or
+    // below every kept one
+    uint32_t keep = (uint32_t)(L1_TAPE_SIZE * r->fitness_params.prune_threshold);
+    uint32_t kept = 0;
+    float min_kept = 2.0f, max_reset = -1.0f;
+    for (uint32_t i = 0; i < L1_TAPE_SIZE; i++) {
+        if (r->tape.fitness[i] == fitness[i] &&
+            memcmp(&r->tape.cells[i], &cells[i], sizeof(R_Cell)) == 0) {
+            kept++;
+            if (fitness[i] < min_kept) min_kept = fitness[i];
+        } else {
+            assert(r->tape.fitness[i] == 0.0f && r->tape.cells[i].gate == 0);
+            if (fitness[i] > max_reset) max_reset = fitness[i];
+        }
+    }
+
+    printf("Kept %u of %u entries (quota %u)\n", kept, L1_TAPE_SIZE, keep);
+    printf("Lowest kept fitness %.4f, highest pruned %.4f\n", min_kept, max_reset);
+
+    assert(kept >= keep);
+    assert(max_reset <= min_kept);
+    assert(l2a_get_tape_entry(r, 900).essential && r->tape.fitness[900] == 1.0f);
+    assert(r->pruning_cycles == 1);
+
+    printf("✓ Pruning keeps the fittest entries in place\n");
+
+    // Incrementally maintained fitness matches a full live recompute
+    for (uint32_t i = 0; i < 300; i++) {
+        l2a_CNOT(r, i % 8, (i * 3 + 1) % 8);
+        if (i % 5 == 0) l2a_NOT(r, i % 8);
+    }
+    l2a_tune_fitness(r, params);
+    for (uint32_t i = 0; i < L1_TAPE_SIZE; i++) {
+        assert(r->tape.fitness[i] == l2a_compute_fitness(r, i));
+    }
+
+    printf("✓ Incremental fitness matches full recompute\n");
+
+    l2a_free(r);
+}
+
+void test_fast_record() {
+    printf("\n=== Test 7: Fast Recording (metadata-only fitness) ===\n");
+
+    L2a_Runtime* r = l2a_init(4, 8, QUBIT_BACKEND_CLASSICAL);
+    l2a_set_fast_record(r, true);
+
+    for (uint32_t i = 0; i < 100; i++) {
+        l2a_CNOT(r, i % 4, (i + 1) % 4);
+    }
+
+    // Every slot overwritten so far held an in-range CCNOT(0,0,0): 3 reads each
+    Tape_Stats stats = l2a_get_tape_stats(r);
+    printf("Reads avoided: %llu\n", (unsigned long long)stats.reads_avoided);
+    assert(stats.reads_avoided == 300);
+    assert(r->total_ops == 100);
+
+    // New entries carry gate + recency fitness until the next prune
+    Fitness_Params params = l2a_get_fitness_params(r);
+    float expected = params.recency_weight + params.gate_weight * 0.3f;
+    assert(r->tape.fitness[99] == expected);
+
+    // Pruning folds the deferred activity back in
+    l2a_prune_tape(r);
+    for (uint32_t i = 0; i < L1_TAPE_SIZE; i++) {
+        assert(r->tape.fitness[i] == 0.0f || r->tape.fitness[i] == l2a_compute_fitness(r, i));
+    }
+
+    printf("✓ Fast recording skips qubit reads on the gate path\n");
+
+    l2a_free(r);
+}
+
+void test_simd_kernels() {
+    printf("\n=== Test 8: SIMD Tape Kernels ===\n");
+
+    L2a_Runtime* r = l2a_init(8, 9, QUBIT_BACKEND_CLASSICAL);
+    uint32_t seed = 99;
+    for (uint32_t i = 0; i < 700; i++) {
+        seed = seed * 1103515245u + 12345u;
+        l2a_CCNOT(r, (seed >> 8) % 8, (seed >> 12) % 8, (seed >> 16) % 8);
+        if (i % 3 == 0) l2a_NOT(r, (seed >> 20) % 8);
+    }
+    for (uint32_t i = 0; i < L1_TAPE_SIZE; i += 37) l2a_mark_essential(r, i);
+    for (uint32_t i = 0; i < 64; i++) l2a_mark_essential(r, 128 + i);  // Whole SIMD blocks
+    r->tape.last_used[300] = r->total_ops + 5;  // Age wraps past 2^31
+    r->tape.cells[301].gate = 9;               // Unknown gate: zero priority
+
+    // Scalar reference
+    static float expected[L1_TAPE_SIZE];
+    tape_kernels_scalar.batch_fitness(&r->tape, L1_TAPE_SIZE, r->total_ops, &r->fitness_params);
+    memcpy(expected, r->tape.fitness, sizeof(expected));
+    float ref_min = 1.0f, ref_max = 0.0f, ref_sum;
+    tape_kernels_scalar.fitness_stats(expected, L1_TAPE_SIZE, &ref_min, &ref_max, &ref_sum);
+    uint32_t ref_active = tape_kernels_scalar.active_count(r->tape.cells, L1_TAPE_SIZE);
+    uint32_t ref_essential = tape_kernels_scalar.essential_count(r->tape.essential, L1_TAPE_SIZE / 64);
+
+    const Tape_Kernels* variants[8];
+    uint32_t count = tape_kernels_supported(variants, 8);
+    printf("Selected kernels: %s (%u variants)\n", tape_kernels()->name, count);
+
+    for (uint32_t v = 0; v < count; v++) {
+        const Tape_Kernels* k = variants[v];
+
+        // Batch fitness is bit-identical, essential entries untouched
+        for (uint32_t i = 0; i < L1_TAPE_SIZE; i++) {
+            r->tape.fitness[i] = (r->tape.essential[i >> 6] >> (i & 63)) & 1 ? 1.0f : -1.0f;
+        }
+        k->batch_fitness(&r->tape, L1_TAPE_SIZE, r->total_ops, &r->fitness_params);
+        assert(memcmp(r->tape.fitness, expected, sizeof(expected)) == 0);
+
+        float min = 1.0f, max = 0.0f, sum;
+        k->fitness_stats(expected, L1_TAPE_SIZE, &min, &max, &sum);
+        assert(min == ref_min && max == ref_max);
+        assert(fabsf(sum - ref_sum) < 1e-3f);
+        assert(k->active_count(r->tape.cells, L1_TAPE_SIZE) == ref_active);
+        assert(k->essential_count(r->tape.essential, L1_TAPE_SIZE / 64) == ref_essential);
+
+        printf("  %-6s matches scalar\n", k->name);
+    }
+
+    printf("✓ SIMD kernels match the scalar reference\n");
+
+    l2a_free(r);
+}
+
+void test_sized_tape() {
+    printf("\n=== Test 9: Sized and Growable Tape ===\n");
+
+    // Capacity rounds up to a power of two (minimum one bitmap word)
+    L2a_Runtime* r = l2a_init_sized(8, 10, QUBIT_BACKEND_CLASSICAL, 100, false);
+    assert(r->tape.size == 128 && r->tape.mask == 127);
+    l2a_free(r);
+    r = l2a_init_sized(8, 10, QUBIT_BACKEND_CLASSICAL, 10, false);
+    assert(r->tape.size == L2A_MIN_TAPE_SIZE);
+    l2a_free(r);
+    printf("✓ Sizes round to powers of two\n");
+
+    // The op after a checkpoint is pinned, and a growable tape doubles
+    // instead of wrapping onto it
+    r = l2a_init_sized(8, 10, QUBIT_BACKEND_CLASSICAL, 64, true);
+    uint32_t cp = l2a_checkpoint(r);
+    assert(cp == 0);
+
+    uint32_t seed = 7;
+    for (uint32_t i = 0; i < 200; i++) {
+        seed = seed * 1103515245u + 12345u;
+        if (i % 2) l2a_NOT(r, (seed >> 8) % 8);
+        else l2a_CNOT(r, (seed >> 12) % 8, ((seed >> 12) + 1 + (seed >> 16) % 7) % 8);
+    }
+    Tape_Stats stats = l2a_get_tape_stats(r);
+    printf("Tape grew to %u entries after %u ops\n", stats.tape_size, r->total_ops);
+    assert(stats.tape_size == 256);
+    assert(l2a_get_tape_entry(r, 0).essential);
+    assert(r->tape_head == (r->total_ops & r->tape.mask));
+
+    // Restore replays every op back to the checkpoint
+    l2a_restore(r, cp);
+    assert(r->total_ops == 0 && r->tape_head == 0);
+    for (uint8_t q = 0; q < 8; q++) assert(qubit_read(r->qubit_state, q) == 0);
+    printf("✓ Checkpoint survives growth and restores initial state\n");
+
+    l2a_free(r);
+
+    // Checkpoints with no op in between pin the same slot: no growth
+    r = l2a_init_sized(8, 10, QUBIT_BACKEND_CLASSICAL, 64, true);
+    l2a_NOT(r, 0);
+    for (uint32_t i = 0; i < 10; i++) assert(l2a_checkpoint(r) == 1);
+    assert(r->tape.size == 64 && r->tape_head == 1);
+    l2a_NOT(r, 1);
+    assert(l2a_get_tape_entry(r, 1).essential && l2a_get_tape_entry(r, 1).cell.a == 1);
+    l2a_free(r);
+    printf("✓ Repeated checkpoints do not grow the tape\n");
+
+    // A checkpoint left pending by a restore must not pin a later slot
+    for (uint32_t growable = 0; growable < 2; growable++) {
+        r = l2a_init_sized(8, 10, QUBIT_BACKEND_CLASSICAL, 64, growable);
+        uint32_t cp_a = l2a_checkpoint(r);
+        l2a_NOT(r, 0);
+        l2a_checkpoint(r);
+        l2a_restore(r, cp_a);
+        l2a_NOT(r, 1);
+        l2a_NOT(r, 2);
+        assert(r->total_ops == 2);
+        l2a_restore(r, cp_a);
+        assert(r->total_ops == 0 && r->tape.size == 64);
+        for (uint8_t q = 0; q < 8; q++) assert(qubit_read(r->qubit_state, q) == 0);
+        l2a_free(r);
+    }
+    printf("✓ Restore drops a checkpoint pending at the head\n");
+}
+
+void test_restore_snapshots() {
+    printf("\n=== Test 10: Restore Snapshots ===\n");
+
+    // Same op stream on two runtimes; only one keeps snapshots
+    L2a_Runtime* plain = l2a_init(8, 11, QUBIT_BACKEND_CLASSICAL);
+    L2a_Runtime* snap = l2a_init(8, 12, QUBIT_BACKEND_CLASSICAL);
+    assert(l2a_set_snapshots(snap, 32, 4));
+
+    uint32_t cp_plain = l2a_checkpoint(plain);
+    uint32_t cp_snap = l2a_checkpoint(snap);
+    uint32_t seed = 21;
+    for (uint32_t i = 0; i < 180; i++) {  // 240 ops, below the prune interval
+        seed = seed * 1103515245u + 12345u;
+        uint8_t a = (seed >> 8) % 8, b = (a + 1 + (seed >> 12) % 7) % 8, c = (seed >> 16) % 8;
+        while (c == a || c == b) c = (c + 1) % 8;  // Keep CCNOT reversible
+        l2a_CCNOT(plain, a, b, c); l2a_CCNOT(snap, a, b, c);
+        if (i % 3 == 0) { l2a_NOT(plain, c); l2a_NOT(snap, c); }
+    }
+
+    // Mid-history restore (no checkpoint there) replays from a periodic snapshot
+    l2a_restore(plain, 150);
+    l2a_restore(snap, 150);
+    assert(plain->total_ops == 150 && snap->total_ops == 150);
+    assert(snap->tape_head == plain->tape_head);
+    for (uint8_t q = 0; q < 8; q++) {
+        assert(qubit_read(snap->qubit_state, q) == qubit_read(plain->qubit_state, q));
+    }
+    for (uint32_t i = 0; i < snap->snapshot_count; i++) {
+        assert(!snap->snapshots[i].valid || snap->snapshots[i].position <= 150);
+    }
+    printf("✓ Restore to op 150 matches gate-by-gate rewind\n");
+
+    // The ring has evicted the checkpoint copy; restore still reaches it
+    l2a_restore(plain, cp_plain);
+    l2a_restore(snap, cp_snap);
+    for (uint8_t q = 0; q < 8; q++) {
+        assert(qubit_read(snap->qubit_state, q) == 0);
+        assert(qubit_read(plain->qubit_state, q) == 0);
+    }
+    assert(l2a_get_tape_entry(snap, 0).essential);
+    printf("✓ Restore to checkpoint returns to the initial state\n");
+
+    l2a_free(plain);
+    l2a_free(snap);
+}
+
+void test_cow_checkpoints() {
+    printf("\n=== Test 11: Copy-on-Write Checkpoints ===\n");
+
+    const Qubit_Backend_Type backends[] = {QUBIT_BACKEND_CLASSICAL, QUBIT_BACKEND_PACKED};
+    for (uint32_t k = 0; k < 2; k++) {
+        L2a_Runtime* r = l2a_init(100, 13, backends[k]);
+        assert(l2a_set_cow_checkpoints(r, true));
+
+        uint32_t seed = 5 + k;
+        for (uint8_t q = 0; q < 100; q += 3) l2a_NOT(r, q);
+        uint8_t before[100];
+        for (uint8_t q = 0; q < 100; q++) before[q] = qubit_read(r->qubit_state, q);
+
+        // Repeated candidate evaluations from one checkpoint
+        uint32_t cp = l2a_checkpoint(r);
+        for (uint32_t candidate = 0; candidate < 8; candidate++) {
+            for (uint32_t i = 0; i < 20; i++) {
+                seed = seed * 1103515245u + 12345u;
+                uint8_t a = (seed >> 8) % 100, b = (a + 1 + (seed >> 16) % 99) % 100;
+                if (i % 3 == 0) l2a_SWAP(r, a, b);
+                else if (i % 3 == 1) l2a_CNOT(r, a, b);
+                else l2a_NOT(r, b);
+            }
+            assert(r->cow_dirty != 0);
+            l2a_restore(r, cp);
+            assert(r->total_ops == cp && r->cow_dirty == 0);
+            for (uint8_t q = 0; q < 100; q++) assert(qubit_read(r->qubit_state, q) == before[q]);
+        }
+
+        // An older checkpoint falls back to rewinding
+        l2a_checkpoint(r);
+        l2a_NOT(r, 99);
+        l2a_restore(r, 0);
+        assert(!r->cow_active);
+        for (uint8_t q = 0; q < 100; q++) assert(qubit_read(r->qubit_state, q) == 0);
+
+        l2a_free(r);
+    }
+    printf("✓ Classical and packed restores copy back only dirty words\n");
+
+#ifndef MOOP_FIXED_BACKEND
+    // No flat bit storage on the bit-sliced backend
+    L2a_Runtime* r = l2a_init(8, 14, QUBIT_BACKEND_BITSLICED);
+    assert(!l2a_set_cow_checkpoints(r, true));
+    l2a_free(r);
+    printf("✓ Other backends refuse copy-on-write\n");
+#endif
+}
+
+void test_execute_batch() {
+    printf("\n=== Test 12: Batched Gate Submission ===\n");
+
+    // Random reversible stream, long enough to wrap a 64-entry tape
+    R_Cell cells[150];
+    uint32_t seed = 33;
+    for (uint32_t i = 0; i < 150; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint8_t a = (seed >> 8) % 70, b = (a + 1 + (seed >> 16) % 69) % 70;
+        uint8_t c = (b + 1) % 70;
+        if (c == a) c = (c + 1) % 70;
+        // Unused operands zeroed, as the l2a_* gates record them
+        uint8_t gate = (seed >> 24) % 4;
+        cells[i] = (R_Cell){gate, a, gate == 2 ? 0 : b, gate == 0 ? c : 0};
+    }
+
+    const Qubit_Backend_Type backends[] = {QUBIT_BACKEND_CLASSICAL, QUBIT_BACKEND_PACKED};
+    for (uint32_t k = 0; k < 2; k++) {
+        L2a_Runtime* gates = l2a_init_sized(70, 15, backends[k], 64, false);
+        L2a_Runtime* batch = l2a_init_sized(70, 16, backends[k], 64, false);
+        l2a_set_fast_record(gates, true);  // Fitness independent of mid-batch state
+        l2a_set_fast_record(batch, true);
+
+        // Checkpoint mid-stream, so the batch crosses a pinned slot and a wrap
+        for (uint32_t i = 0; i < 150; i++) {
+            if (i == 20) l2a_checkpoint(gates);
+            R_Cell c = cells[i];
+            switch (c.gate) {
+                case 0: l2a_CCNOT(gates, c.a, c.b, c.c); break;
+                case 1: l2a_CNOT(gates, c.a, c.b); break;
+                case 2: l2a_NOT(gates, c.a); break;
+                case 3: l2a_SWAP(gates, c.a, c.b); break;
+            }
+        }
+        l2a_execute_batch(batch, cells, 20);
+        l2a_checkpoint(batch);
+        l2a_execute_batch(batch, cells + 20, 130);
+
+        assert(batch->total_ops == gates->total_ops);
+        assert(batch->tape_head == gates->tape_head && batch->tape_wrapped);
+        for (uint8_t q = 0; q < 70; q++) {
+            assert(qubit_read(batch->qubit_state, q) == qubit_read(gates->qubit_state, q));
+        }
+        for (uint32_t i = 0; i < 64; i++) {
+            Tape_Entry a = l2a_get_tape_entry(gates, i), b = l2a_get_tape_entry(batch, i);
+            assert(memcmp(&a.cell, &b.cell, sizeof(R_Cell)) == 0);
+            assert(a.essential == b.essential && a.last_used == b.last_used);
+        }
+
+        l2a_free(gates);
+        l2a_free(batch);
+    }
+    printf("✓ Batch matches gate-by-gate state and tape layout\n");
+
+    // The prune trigger fires once for the whole batch (per gate: twice)
+    R_Cell nots[600];
+    for (uint32_t i = 0; i < 600; i++) nots[i] = (R_Cell){2, i % 70, 0, 0};
+    L2a_Runtime* r = l2a_init(70, 17, QUBIT_BACKEND_CLASSICAL);
+    l2a_execute_batch(r, nots, 600);
+    assert(r->total_ops == 600 && r->pruning_cycles == 1);
+    l2a_free(r);
+    printf("✓ One prune cycle per batch\n");
+
+    // Copy-on-write sees every batched write
+    r = l2a_init(70, 18, QUBIT_BACKEND_PACKED);
+    assert(l2a_set_cow_checkpoints(r, true));
+    uint32_t cp = l2a_checkpoint(r);
+    l2a_execute_batch(r, cells, 150);
+    l2a_restore(r, cp);
+    for (uint8_t q = 0; q < 70; q++) assert(qubit_read(r->qubit_state, q) == 0);
+    l2a_free(r);
+    printf("✓ Batched gates restore through copy-on-write\n");
+}
+
+void test_programs() {
+    printf("\n=== Test 13: Threaded-Code Programs ===\n");
+
+    R_Cell cells[200];
+    uint32_t seed = 47;
+    for (uint32_t i = 0; i < 200; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint8_t a = (seed >> 8) % 90, b = (a + 1 + (seed >> 16) % 89) % 90;
+        uint8_t c = (b + 1) % 90 == a ? (b + 2) % 90 : (b + 1) % 90;
+        cells[i] = (R_Cell){(seed >> 24) % 5, a, b, c};  // Gate 4 is dropped
+    }
+
+    // Program output matches the qubit_* switch loop on every backend
+#ifndef MOOP_FIXED_BACKEND
+    const Qubit_Backend_Type backends[] = {QUBIT_BACKEND_CLASSICAL, QUBIT_BACKEND_PACKED,
+                                           QUBIT_BACKEND_BITSLICED};
+#else
+    const Qubit_Backend_Type backends[] = {MOOP_FIXED_BACKEND};
+#endif
+    for (uint32_t k = 0; k < sizeof(backends) / sizeof(backends[0]); k++) {
+        Qubit_State* expected = qubit_init(90, backends[k]);
+        Qubit_State* actual = qubit_init(90, backends[k]);
+        for (uint32_t i = 0; i < 200; i++) {
+            R_Cell c = cells[i];
+            switch (c.gate) {
+                case 0: qubit_CCNOT(expected, c.a, c.b, c.c); break;
+                case 1: qubit_CNOT(expected, c.a, c.b); break;
+                case 2: qubit_NOT(expected, c.a); break;
+                case 3: qubit_SWAP(expected, c.a, c.b); break;
+            }
+        }
+
+        L2a_Program* p = l2a_program_compile(cells, 200, backends[k]);
+        assert(p && p->length < 200);
+        assert(l2a_program_run(p, actual));
+        for (uint8_t q = 0; q < 90; q++) assert(qubit_read(actual, q) == qubit_read(expected, q));
+        l2a_program_free(p);
+        qubit_free(expected);
+        qubit_free(actual);
+    }
+    printf("✓ Threaded dispatch matches the switch loop\n");
+
+    // A recorded tape range replays forward onto a fresh runtime
+    L2a_Runtime* recorded = l2a_init(90, 19, QUBIT_BACKEND_PACKED);
+    l2a_execute_batch(recorded, cells, 100);  // 100 ops, under the prune interval
+    L2a_Program* p = l2a_program_from_tape(recorded, 0, 500);
+    assert(p && p->length > 0 && p->length <= recorded->total_ops);
+
+    L2a_Runtime* r = l2a_init(90, 20, QUBIT_BACKEND_PACKED);
+    assert(l2a_set_cow_checkpoints(r, true));
+    uint32_t cp = l2a_checkpoint(r);
+    assert(l2a_run_program(r, p));
+    assert(r->total_ops == 0);  // Not recorded
+    for (uint8_t q = 0; q < 90; q++) {
+        assert(qubit_read(r->qubit_state, q) == qubit_read(recorded->qubit_state, q));
+    }
+    l2a_restore(r, cp);
+    for (uint8_t q = 0; q < 90; q++) assert(qubit_read(r->qubit_state, q) == 0);
+
+    L2a_Runtime* other = l2a_init(90, 21, QUBIT_BACKEND_CLASSICAL);
+#ifndef MOOP_FIXED_BACKEND
+    assert(!l2a_run_program(other, p));  // Compiled for packed
+#endif
+    l2a_free(other);
+    l2a_program_free(p);
+    l2a_free(recorded);
+    l2a_free(r);
+    printf("✓ Tape programs replay forward and restore through copy-on-write\n");
+}
+
+static void apply_cells(Qubit_State* s, const R_Cell* cells, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        R_Cell c = cells[i];
+        switch (c.gate) {
+            case 0: qubit_CCNOT(s, c.a, c.b, c.c); break;
+            case 1: qubit_CNOT(s, c.a, c.b); break;
+            case 2: qubit_NOT(s, c.a); break;
+            case 3: qubit_SWAP(s, c.a, c.b); break;
+        }
+    }
+}
+
+void test_jit() {
+    printf("\n=== Test 14: Gate-Sequence JIT ===\n");
+
+    // Operands across all four words of a 256-qubit packed state
+    R_Cell cells[300];
+    uint32_t seed = 61;
+    for (uint32_t i = 0; i < 300; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint8_t a = seed >> 8, b = seed >> 16, c = seed >> 24;
+        cells[i] = (R_Cell){i % 4, a, b, c};
+    }
+
+    const Qubit_Backend_Type backends[] = {QUBIT_BACKEND_PACKED, QUBIT_BACKEND_CLASSICAL};
+    for (uint32_t k = 0; k < 2; k++) {
+        L2a_Runtime* r = l2a_init(256, 22, backends[k]);
+        Qubit_State* expected = qubit_init(256, backends[k]);
+        assert(l2a_set_jit(r, 4));
+
+        for (uint32_t pass = 0; pass < 3; pass++) {
+            assert(l2a_jit_run(r, cells, 300));
+            for (uint32_t i = 0; i < 300; i++) {
+                R_Cell c = cells[i];
+                switch (c.gate) {
+                    case 0: qubit_CCNOT(expected, c.a, c.b, c.c); break;
+                    case 1: qubit_CNOT(expected, c.a, c.b); break;
+                    case 2: qubit_NOT(expected, c.a); break;
+                    case 3: qubit_SWAP(expected, c.a, c.b); break;
+                }
+            }
+            for (uint32_t q = 0; q < 256; q++) {
+                assert(qubit_read(r->qubit_state, q) == qubit_read(expected, q));
+            }
+        }
+        assert(r->jit->compiles == 1 && r->total_ops == 0);
+#ifdef GATE_JIT_X86_64
+        assert((r->jit->entries[0].native != NULL) ==
+               (r->qubit_state->backend_type == QUBIT_BACKEND_PACKED));
+#endif
+
+        qubit_free(expected);
+        l2a_free(r);
+    }
+    printf("✓ Compiled sequences match the gate kernels and are cached\n");
+
+    // Operands past the state's words are rejected
+    L2a_Runtime* r = l2a_init(64, 23, QUBIT_BACKEND_PACKED);
+    assert(!l2a_jit_run(r, cells, 1));  // JIT off
+    assert(l2a_set_jit(r, 4));
+    assert(l2a_jit_run(r, NULL, 0) && r->jit->compiles == 0);
+#ifdef GATE_JIT_X86_64
+    R_Cell far = {2, 200, 0, 0};
+    if (r->qubit_state->backend_type == QUBIT_BACKEND_PACKED) assert(!l2a_jit_run(r, &far, 1));
+#endif
+
+    // Tape ranges: cached by slot span, dropped when the tape is edited
+    for (uint8_t q = 0; q < 8; q++) l2a_CNOT(r, q, q + 8);
+    for (uint8_t q = 0; q < 8; q++) l2a_NOT(r, q);
+    assert(l2a_jit_run_tape(r, 8, 16));
+    assert(l2a_jit_run_tape(r, 8, 16));
+    uint32_t compiles = r->jit->compiles;
+    for (uint8_t q = 0; q < 8; q++) assert(qubit_read(r->qubit_state, q) == 1);
+
+    l2a_write_tape(r, 10, (R_Cell){2, 40, 0, 0});
+    assert(!r->jit->entries[compiles - 1].valid);
+    assert(l2a_jit_run_tape(r, 8, 16));
+    assert(r->jit->compiles == compiles + 1);
+    assert(qubit_read(r->qubit_state, 40) == 1 && qubit_read(r->qubit_state, 2) == 1);
+
+    // Recording over the range is caught by the content check
+    assert(l2a_jit_run_tape(r, 8, 13));
+    l2a_restore(r, 12);
+    l2a_SWAP(r, 50, 51);
+    assert(l2a_jit_run_tape(r, 8, 13));
+    assert(l2a_jit_run_tape(r, 8, 13));
+    assert(r->jit->compiles == compiles + 3);
+
+    l2a_set_jit(r, 0);
+    assert(r->jit == NULL);
+    l2a_free(r);
+    printf("✓ Tape ranges recompile after edits\n");
+
+#if defined(GATE_JIT_X86_64) && defined(__linux__)
+    // A host that refuses executable mappings runs the threaded program.
+    // The policy cannot be lifted again, so it is set in a child
+    pid_t child = fork();
+    if (child == 0) {
+        if (prctl(PR_SET_MDWE, PR_MDWE_REFUSE_EXEC_GAIN, 0, 0, 0) != 0) _exit(2);
+        r = l2a_init(256, 24, QUBIT_BACKEND_PACKED);
+        Qubit_State* expected = qubit_init(256, r->qubit_state->backend_type);
+        assert(l2a_set_jit(r, 4));
+        assert(l2a_jit_run(r, cells, 300));
+        assert(r->jit->entries[0].native == NULL && r->jit->entries[0].program);
+        apply_cells(expected, cells, 300);
+        for (uint32_t q = 0; q < 256; q++) {
+            assert(qubit_read(r->qubit_state, q) == qubit_read(expected, q));
+        }
+        l2a_NOT(r, 7);
+        assert(l2a_jit_run_tape(r, 0, 1) && qubit_read(r->qubit_state, 7) == qubit_read(expected, 7));
+        qubit_free(expected);
+        l2a_free(r);
+        _exit(0);
+    }
+    int status = 0;
+    assert(child > 0 && waitpid(child, &status, 0) == child && WIFEXITED(status));
+    if (WEXITSTATUS(status) == 2) {
+        printf("(Kernel lacks PR_SET_MDWE: mapping-failure fallback not exercised)\n");
+    } else {
+        assert(WEXITSTATUS(status) == 0);
+        printf("✓ Refused executable mappings fall back to the threaded program\n");
+    }
+#endif
+}
+
+void test_peephole() {
+    printf("\n=== Test 15: Peephole Optimizer ===\n");
+
+    // Pairs cancel across gates on other qubits, not across a writer
+    R_Cell pairs[] = {
+        {2, 4, 0, 0}, {2, 4, 0, 0},                   // NOT a; NOT a
+        {1, 0, 1, 0}, {2, 5, 0, 0}, {1, 0, 1, 0},     // CNOT around NOT 5
+        {0, 1, 2, 3}, {0, 2, 1, 3},                   // CCNOT, controls swapped
+        {1, 0, 6, 0}, {2, 0, 0, 0}, {1, 0, 6, 0},     // NOT on the control
+        {1, 7, 7, 0}, {1, 7, 7, 0},                   // CNOT a a is not reversible
+        {3, 9, 9, 0}                                  // SWAP a a
+    };
+    L2a_Opt_Stats stats;
+    uint32_t n = l2a_optimize(pairs, 13, &stats);
+    assert(n == 6 && stats.cancelled == 7 && stats.output_gates == 6);
+    assert(pairs[0].gate == 2 && pairs[0].a == 5);
+    assert(pairs[1].gate == 1 && pairs[2].gate == 2 && pairs[3].gate == 1);
+    printf("✓ Self-inverse pairs cancel only across commuting gates\n");
+
+    // Two l2b_OR expansions back to back share four NOTs
+    R_Cell ors[12];
+    for (uint32_t k = 0; k < 2; k++) {
+        R_Cell* o = &ors[k * 6];
+        o[0] = (R_Cell){2, 0, 0, 0};
+        o[1] = (R_Cell){2, 1, 0, 0};
+        o[2] = (R_Cell){0, 0, 1, 2 + k};
+        o[3] = (R_Cell){2, 2 + k, 0, 0};
+        o[4] = (R_Cell){2, 0, 0, 0};
+        o[5] = (R_Cell){2, 1, 0, 0};
+    }
+    assert(l2a_optimize(ors, 12, NULL) == 8);
+
+    // SWAP 0 1; SWAP 1 2; SWAP 0 1 is SWAP 0 2
+    R_Cell swaps[] = {{3, 0, 1, 0}, {3, 1, 2, 0}, {3, 0, 1, 0}};
+    assert(l2a_optimize(swaps, 3, &stats) == 1 && stats.swaps_merged == 2);
+    assert(swaps[0].gate == 3 && ((swaps[0].a == 0 && swaps[0].b == 2) ||
+                                  (swaps[0].a == 2 && swaps[0].b == 0)));
+    printf("✓ OR chains and SWAP chains shrink\n");
+
+    // Random redundant sequences keep their effect
+    R_Cell cells[2000], optimized[2000];
+    uint32_t seed = 83;
+    for (uint32_t i = 0; i < 2000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint8_t a = (seed >> 8) % 12, b = (seed >> 12) % 12, c = (seed >> 16) % 12;
+        uint8_t gate = (seed >> 24) % 9;
+        cells[i] = (R_Cell){gate < 4 ? gate : (gate == 8 ? 4 : 3 - gate % 2), a, b, c};
+    }
+    memcpy(optimized, cells, sizeof(cells));
+    n = l2a_optimize(optimized, 2000, &stats);
+    assert(n < 2000 && stats.input_gates == 2000);
+    assert(stats.cancelled + stats.swaps_merged == 2000 - n);
+
+    Qubit_State* expected = qubit_init(12, QUBIT_BACKEND_CLASSICAL);
+    Qubit_State* actual = qubit_init(12, QUBIT_BACKEND_CLASSICAL);
+    for (uint8_t q = 0; q < 12; q += 3) {
+        qubit_NOT(expected, q);
+        qubit_NOT(actual, q);
+    }
+    apply_cells(expected, cells, 2000);
+    apply_cells(actual, optimized, n);
+    for (uint8_t q = 0; q < 12; q++) assert(qubit_read(actual, q) == qubit_read(expected, q));
+    qubit_free(expected);
+    qubit_free(actual);
+    printf("✓ Optimized sequences are equivalent (%u -> %u gates)\n", 2000, n);
+
+    // Batches record the optimized cells; the JIT keys on the originals
+    L2a_Runtime* r = l2a_init(12, 24, QUBIT_BACKEND_PACKED);
+    L2a_Runtime* plain = l2a_init(12, 25, QUBIT_BACKEND_PACKED);
+    l2a_set_optimize(r, true);
+    l2a_execute_batch(r, cells, 200);
+    l2a_execute_batch(plain, cells, 200);
+    assert(r->total_ops < 200 && r->opt_stats.input_gates == 200);
+    assert(r->opt_stats.output_gates == r->total_ops);
+    for (uint8_t q = 0; q < 12; q++) {
+        assert(qubit_read(r->qubit_state, q) == qubit_read(plain->qubit_state, q));
+    }
+
+    assert(l2a_set_jit(r, 2) && l2a_set_jit(plain, 2));
+    for (uint32_t pass = 0; pass < 2; pass++) {
+        assert(l2a_jit_run(r, cells, 2000));
+        assert(l2a_jit_run(plain, cells, 2000));
+    }
+    assert(r->jit->compiles == 1 && r->opt_stats.input_gates == 2200);
+    for (uint8_t q = 0; q < 12; q++) {
+        assert(qubit_read(r->qubit_state, q) == qubit_read(plain->qubit_state, q));
+    }
+    l2a_free(r);
+    l2a_free(plain);
+    printf("✓ Batch and JIT paths run the optimized sequence\n");
+}
+
+void test_l2b_direct() {
+    printf("\n=== Test 16: Direct L2b Boolean Ops ===\n");
+
+    typedef void (*L2b_Fn)(L2b_Runtime*, uint8_t, uint8_t, uint8_t);
+    const L2b_Fn fns[] = {l2b_AND, l2b_OR, l2b_XOR, l2b_NAND, l2b_NOR};
+    const Qubit_Backend_Type backends[] = {QUBIT_BACKEND_CLASSICAL, QUBIT_BACKEND_PACKED};
+
+    // Same truth tables as the reversible expansions, one cell per op
+    for (uint32_t k = 0; k < 2; k++) {
+        for (uint32_t op = 0; op < 5; op++) {
+            for (uint32_t in = 0; in < 8; in++) {
+                L2a_Runtime* rev = l2a_init(70, 26, backends[k]);
+                L2a_Runtime* dir = l2a_init(70, 27, backends[k]);
+                L2b_Runtime* lrev = l2b_init(rev);
+                L2b_Runtime* ldir = l2b_init(dir);
+                assert(l2b_set_direct(ldir, true));
+
+                // Inputs and the old result span two packed words
+                const uint8_t q[3] = {3, 65, 40};
+                for (uint32_t bit = 0; bit < 3; bit++) {
+                    if (in & (1u << bit)) {
+                        qubit_NOT(rev->qubit_state, q[bit]);
+                        qubit_NOT(dir->qubit_state, q[bit]);
+                    }
+                }
+                fns[op](lrev, q[0], q[1], q[2]);
+                fns[op](ldir, q[0], q[1], q[2]);
+
+                assert(dir->total_ops == 1);
+                R_Cell cell = l2a_read_tape(dir, 0);
+                assert(l2a_is_dissipative(cell.gate) && (cell.gate & 1) == ((in >> 2) & 1));
+                for (uint8_t i = 0; i < 70; i++) {
+                    assert(qubit_read(dir->qubit_state, i) == qubit_read(rev->qubit_state, i));
+                }
+
+                // Undo restores the overwritten bit
+                l2a_restore(dir, 0);
+                assert(qubit_read(dir->qubit_state, q[2]) == ((in >> 2) & 1));
+
+                l2b_free(lrev);
+                l2b_free(ldir);
+                l2a_free(rev);
+                l2a_free(dir);
+            }
+        }
+    }
+    printf("✓ AND/OR/XOR/NAND/NOR match the reversible expansions\n");
+
+    // A mixed history replays both ways: snapshots (forward), rewinding,
+    // copy-on-write, tape programs and the JIT
+    L2a_Runtime* r = l2a_init(64, 28, QUBIT_BACKEND_PACKED);
+    L2b_Runtime* l2b = l2b_init(r);
+    assert(l2b_set_direct(l2b, true));
+    assert(l2a_set_snapshots(r, 16, 4));
+    uint32_t seed = 97;
+    uint8_t states[101][64];
+    for (uint32_t i = 0; i < 100; i++) {
+        for (uint8_t q = 0; q < 64; q++) states[i][q] = qubit_read(r->qubit_state, q);
+        seed = seed * 1103515245u + 12345u;
+        uint8_t a = (seed >> 8) % 64, b = (seed >> 14) % 64, c = (seed >> 20) % 64;
+        if (i % 3 == 0) l2a_NOT(r, a);
+        else fns[(seed >> 26) % 5](l2b, a, b, c);
+    }
+    for (uint8_t q = 0; q < 64; q++) states[100][q] = qubit_read(r->qubit_state, q);
+
+    const uint32_t targets[] = {90, 70, 37, 5, 0};
+    for (uint32_t t = 0; t < 5; t++) {
+        l2a_restore(r, targets[t]);
+        for (uint8_t q = 0; q < 64; q++) assert(qubit_read(r->qubit_state, q) == states[targets[t]][q]);
+    }
+
+    printf("✓ Dissipative cells undo through snapshots and rewinding\n");
+    l2b_free(l2b);
+    l2a_free(r);
+
+    // Forward replay of a recorded range: threaded program and JIT
+    for (uint32_t k = 0; k < 2; k++) {
+        r = l2a_init(64, 29, backends[k]);
+        l2b = l2b_init(r);
+        assert(l2b_set_direct(l2b, true));
+        for (uint8_t q = 0; q < 8; q++) l2a_NOT(r, q * 3);
+        for (uint32_t i = 0; i < 40; i++) {
+            seed = seed * 1103515245u + 12345u;
+            fns[i % 5](l2b, (seed >> 8) % 64, (seed >> 14) % 64, (seed >> 20) % 64);
+        }
+        L2a_Runtime* copy = l2a_init(64, 30, backends[k]);
+        L2a_Runtime* jit = l2a_init(64, 31, backends[k]);
+        assert(l2a_set_jit(jit, 2));
+        for (uint8_t q = 0; q < 8; q++) {
+            qubit_NOT(copy->qubit_state, q * 3);
+            qubit_NOT(jit->qubit_state, q * 3);
+        }
+        L2a_Program* p = l2a_program_from_tape(r, 8, 48);
+        assert(p && p->length == 40 && l2a_run_program(copy, p));
+
+        R_Cell cells[40];
+        for (uint32_t i = 0; i < 40; i++) cells[i] = l2a_read_tape(r, 8 + i);
+        assert(l2a_jit_run(jit, cells, 40));
+        for (uint8_t q = 0; q < 64; q++) {
+            assert(qubit_read(copy->qubit_state, q) == qubit_read(r->qubit_state, q));
+            assert(qubit_read(jit->qubit_state, q) == qubit_read(r->qubit_state, q));
+        }
+        l2a_program_free(p);
+        l2a_free(copy);
+        l2a_free(jit);
+        l2b_free(l2b);
+        l2a_free(r);
+    }
+    printf("✓ Programs and the JIT recompute dissipative cells forward\n");
+
+    // Batched dissipative cells run and record the bit they overwrite,
+    // matching the l2b_* calls cell for cell
+    for (uint32_t k = 0; k < 2; k++) {
+        r = l2a_init(64, 33, backends[k]);
+        qubit_NOT(r->qubit_state, 0);
+        qubit_NOT(r->qubit_state, 1);
+        const R_Cell and_cell = {L2A_GATE_DISSIPATIVE | L2B_OP_AND << 1, 0, 1, 2};
+        l2a_execute_batch(r, &and_cell, 1);
+        assert(r->total_ops == 1 && qubit_read(r->qubit_state, 2) == 1);
+        l2a_free(r);
+
+        L2a_Runtime* calls = l2a_init_sized(64, 34, backends[k], 256, false);
+        L2a_Runtime* batch = l2a_init_sized(64, 35, backends[k], 256, false);
+        l2a_set_fast_record(calls, true);
+        l2a_set_fast_record(batch, true);
+        l2b = l2b_init(calls);
+        assert(l2b_set_direct(l2b, true));
+        R_Cell cells[120];
+        for (uint32_t i = 0; i < 120; i++) {
+            seed = seed * 1103515245u + 12345u;
+            uint8_t a = (seed >> 8) % 64, b = (seed >> 14) % 64, c = (seed >> 20) % 64;
+            uint32_t op = (seed >> 26) % 5;
+            if (i % 4 == 0) {
+                l2a_NOT(calls, a);
+                cells[i] = (R_Cell){2, a, 0, 0};
+            } else {
+                fns[op](l2b, a, b, c);
+                // The old bit is filled in when the batch runs
+                cells[i] = (R_Cell){(uint8_t)(L2A_GATE_DISSIPATIVE | op << 1), a, b, c};
+            }
+        }
+        l2a_execute_batch(batch, cells, 120);
+
+        assert(batch->total_ops == calls->total_ops);
+        for (uint8_t q = 0; q < 64; q++) {
+            assert(qubit_read(batch->qubit_state, q) == qubit_read(calls->qubit_state, q));
+        }
+        for (uint32_t i = 0; i < 120; i++) {
+            R_Cell x = l2a_read_tape(calls, i), y = l2a_read_tape(batch, i);
+            assert(memcmp(&x, &y, sizeof(R_Cell)) == 0);
+        }
+        l2a_restore(batch, 0);
+        for (uint8_t q = 0; q < 64; q++) assert(qubit_read(batch->qubit_state, q) == 0);
+
+        l2b_free(l2b);
+        l2a_free(calls);
+        l2a_free(batch);
+    }
+    printf("✓ Batched dissipative cells match the l2b_* calls\n");
+
+#ifndef MOOP_FIXED_BACKEND
+    L2a_Runtime* sliced = l2a_init(8, 32, QUBIT_BACKEND_BITSLICED);
+    L2b_Runtime* lsliced = l2b_init(sliced);
+    assert(!l2b_set_direct(lsliced, true) && !lsliced->direct);
+    l2b_free(lsliced);
+    l2a_free(sliced);
+    printf("✓ Direct mode needs flat bit storage\n");
+#endif
+}
+
+// 4-bit ripple-carry adder: a on qubits 0-3, b on 4-7, sum on 8-12
+static L2b_Circuit* build_adder(void) {
+    L2b_Circuit* c = l2b_circuit_create();
+    L2b_Wire carry = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        L2b_Wire a = l2b_circuit_input(c, i);
+        L2b_Wire b = l2b_circuit_input(c, 4 + i);
+        L2b_Wire half = l2b_circuit_gate(c, L2B_OP_XOR, a, b);
+        L2b_Wire both = l2b_circuit_gate(c, L2B_OP_AND, a, b);
+        if (i == 0) {
+            l2b_circuit_output(c, half, 8);
+            carry = both;
+            continue;
+        }
+        l2b_circuit_output(c, l2b_circuit_gate(c, L2B_OP_XOR, half, carry), 8 + i);
+        L2b_Wire propagate = l2b_circuit_gate(c, L2B_OP_AND, half, carry);
+        carry = l2b_circuit_gate(c, L2B_OP_OR, both, propagate);
+    }
+    l2b_circuit_output(c, carry, 12);
+    return c;
+}
+
+void test_l2b_circuits() {
+    printf("\n=== Test 17: Compiled L2b Circuits ===\n");
+
+    L2b_Circuit* adder = build_adder();
+    L2b_Wire unused = l2b_circuit_gate(adder, L2B_OP_NOR, 0, 1);  // No output needs it
+    assert(unused != UINT32_MAX);
+    assert(!l2b_circuit_compile(adder, 16, 1));   // Too few ancillas
+    assert(!l2b_circuit_compile(adder, 6, 32));   // Overlaps the inputs
+    assert(l2b_circuit_compile(adder, 16, 32));
+    assert(adder->cell_count == 17);              // Sums and carry written in place
+    assert(adder->ancillas_used > 0 && adder->ancillas_used <= 4);
+
+    const Qubit_Backend_Type backends[] = {QUBIT_BACKEND_CLASSICAL, QUBIT_BACKEND_PACKED};
+    for (uint32_t k = 0; k < 2; k++) {
+        Qubit_State* s = qubit_init(64, backends[k]);
+        for (uint32_t x = 0; x < 256; x++) {
+            for (uint8_t q = 0; q < 8; q++) {
+                if (qubit_read(s, q) != ((x >> q) & 1)) qubit_NOT(s, q);
+            }
+            assert(l2b_circuit_eval(adder, s));
+            uint32_t sum = 0;
+            for (uint8_t q = 0; q < 5; q++) sum |= (uint32_t)qubit_read(s, 8 + q) << q;
+            assert(sum == (x & 15) + (x >> 4));
+        }
+        qubit_free(s);
+    }
+    printf("✓ Adder matches arithmetic (%u cells, %u ancillas)\n", adder->cell_count,
+           adder->ancillas_used);
+
+    // Runtime evaluation: unrecorded, native when the JIT is on, undone by
+    // copy-on-write
+    L2a_Runtime* r = l2a_init(64, 33, QUBIT_BACKEND_PACKED);
+    L2b_Runtime* l2b = l2b_init(r);
+    assert(l2a_set_cow_checkpoints(r, true) && l2a_set_jit(r, 2));
+    l2a_NOT(r, 3);
+    l2a_NOT(r, 5);
+    uint32_t cp = l2a_checkpoint(r);
+    for (uint32_t i = 0; i < 3; i++) assert(l2b_circuit_run(l2b, adder));
+    assert(r->total_ops == 2 && r->jit->compiles == 1);
+    assert(qubit_read(r->qubit_state, 8 + 3) == 1 && qubit_read(r->qubit_state, 8 + 1) == 1);
+    l2a_restore(r, cp);
+    for (uint8_t q = 8; q < 64; q++) assert(qubit_read(r->qubit_state, q) == 0);
+    l2b_free(l2b);
+    l2a_free(r);
+    l2b_circuit_free(adder);
+    printf("✓ Runtime evaluation restores through copy-on-write\n");
+
+    // Outputs onto input qubits: swap two bits and negate a third in place
+    L2b_Circuit* c = l2b_circuit_create();
+    L2b_Wire a = l2b_circuit_input(c, 0), b = l2b_circuit_input(c, 1), n = l2b_circuit_input(c, 2);
+    l2b_circuit_output(c, a, 1);
+    l2b_circuit_output(c, b, 0);
+    l2b_circuit_output(c, l2b_circuit_gate(c, L2B_OP_NAND, n, n), 2);
+    assert(l2b_circuit_compile(c, 8, 8));
+    Qubit_State* s = qubit_init(16, QUBIT_BACKEND_CLASSICAL);
+    for (uint32_t x = 0; x < 8; x++) {
+        for (uint8_t q = 0; q < 3; q++) {
+            if (qubit_read(s, q) != ((x >> q) & 1)) qubit_NOT(s, q);
+        }
+        assert(l2b_circuit_eval(c, s));
+        assert(qubit_read(s, 0) == ((x >> 1) & 1) && qubit_read(s, 1) == (x & 1));
+        assert(qubit_read(s, 2) == !((x >> 2) & 1));
+    }
+    qubit_free(s);
+    l2b_circuit_free(c);
+    printf("✓ Outputs may overwrite the circuit's own inputs\n");
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -258,6 +1215,18 @@ int main(void) {
     test_natural_language_parser();
     test_layer_segregation();
     test_integrated();
+    test_evolutionary_pruning();
+    test_fast_record();
+    test_simd_kernels();
+    test_sized_tape();
+    test_restore_snapshots();
+    test_cow_checkpoints();
+    test_execute_batch();
+    test_programs();
+    test_jit();
+    test_peephole();
+    test_l2b_direct();
+    test_l2b_circuits();
 
     printf("\n╔════════════════════════════════════════════════════════════╗\n");
     printf("║  ✓ All Enhanced Features Validated                        ║\n");
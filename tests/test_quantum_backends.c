@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <math.h>
 
 // ============================================================================
 // Test Classical Backend
@@ -39,12 +40,162 @@ void test_classical_backend() {
     assert(result0 == 1);
     assert(result1 == 1);
     assert(result2 == 1);
+    assert(qubit_probability(state, 2) == 1.0 && qubit_probability(state, 3) == 0.0);
 
     printf("✓ Classical backend works correctly\n");
 
     qubit_free(state);
 }
 
+#ifndef MOOP_FIXED_BACKEND
+
+// ============================================================================
+// Test Bit-Packed Classical Backend
+// ============================================================================
+
+void test_packed_backend() {
+    printf("\n=== Testing Bit-Packed Classical Backend ===\n");
+
+    // 200 qubits spans four words, exercising cross-word gates
+    Qubit_State* packed = qubit_init(200, QUBIT_BACKEND_PACKED);
+    Qubit_State* reference = qubit_init(200, QUBIT_BACKEND_CLASSICAL);
+    assert(packed != NULL && reference != NULL);
+
+    printf("Backend: %s\n", qubit_backend_name(packed));
+    assert(!qubit_is_quantum(packed));
+
+    // Random gate stream must match the byte-per-qubit backend exactly
+    srand(42);
+    for (int i = 0; i < 20000; i++) {
+        uint8_t a = rand() % 200, b = rand() % 200, c = rand() % 200;
+        switch (rand() % 4) {
+            case 0: qubit_CCNOT(packed, a, b, c); qubit_CCNOT(reference, a, b, c); break;
+            case 1: qubit_CNOT(packed, a, b); qubit_CNOT(reference, a, b); break;
+            case 2: qubit_NOT(packed, a); qubit_NOT(reference, a); break;
+            case 3: qubit_SWAP(packed, a, b); qubit_SWAP(reference, a, b); break;
+        }
+    }
+    for (uint8_t q = 0; q < 200; q++) {
+        assert(qubit_read(packed, q) == qubit_read(reference, q));
+    }
+    printf("20000 random gates match classical backend\n");
+
+    Qubit_State* cloned = qubit_clone(packed);
+    for (uint8_t q = 0; q < 200; q++) {
+        assert(qubit_read(cloned, q) == qubit_read(packed, q));
+    }
+
+    // In-place copy restores a diverged clone; other backends are rejected
+    qubit_NOT(cloned, 5);
+    qubit_NOT(cloned, 150);
+    assert(qubit_copy(cloned, packed));
+    for (uint8_t q = 0; q < 200; q++) {
+        assert(qubit_read(cloned, q) == qubit_read(packed, q));
+    }
+    assert(!qubit_copy(reference, packed));
+    qubit_free(cloned);
+    qubit_free(reference);
+    qubit_free(packed);
+
+    // Bulk ops: NOT a mask, then CNOT controls onto targets 70 qubits higher
+    Qubit_State* bulk = qubit_init(200, QUBIT_BACKEND_PACKED);
+    uint64_t mask[4] = {0x5ULL, 0x8000000000000000ULL, 0, ~0ULL};
+    qubit_packed_NOT_mask(bulk, mask);
+    assert(qubit_read(bulk, 0) == 1 && qubit_read(bulk, 2) == 1);
+    assert(qubit_read(bulk, 127) == 1);
+    assert(qubit_read(bulk, 199) == 1);
+    assert(((Packed_Qubit_State*)bulk->backend_data)->words[3] == 0xFFULL);
+
+    uint64_t controls[4] = {0x7ULL, 0x8000000000000000ULL, 0, 0};
+    qubit_packed_CNOT_mask(bulk, controls, 70);
+    assert(qubit_read(bulk, 70) == 1);   // control 0 set
+    assert(qubit_read(bulk, 71) == 0);   // control 1 clear
+    assert(qubit_read(bulk, 72) == 1);   // control 2 set
+    assert(qubit_read(bulk, 197) == 0);  // control 127 set: 197 flipped 1 -> 0
+    printf("Bulk NOT/CNOT mask operations correct\n");
+
+    qubit_free(bulk);
+
+    printf("✓ Bit-packed backend works correctly\n");
+}
+
+// ============================================================================
+// Test Bit-Sliced Multi-Instance Backend
+// ============================================================================
+
+void test_bitsliced_backend() {
+    printf("\n=== Testing Bit-Sliced Multi-Instance Backend ===\n");
+
+    Qubit_State* state = qubit_init(3, QUBIT_BACKEND_BITSLICED);
+    assert(state != NULL);
+
+    printf("Backend: %s (%d lanes)\n", qubit_backend_name(state), BITSLICE_LANES);
+
+    // Lane k holds inputs a = bit 0 of k, b = bit 1 of k
+    for (uint32_t lane = 0; lane < BITSLICE_LANES; lane++) {
+        qubit_bitsliced_set_lane(state, lane, 0, lane & 1);
+        qubit_bitsliced_set_lane(state, lane, 1, (lane >> 1) & 1);
+    }
+
+    // Full adder style: q2 = a AND b, then q1 = a XOR b
+    qubit_CCNOT(state, 0, 1, 2);
+    qubit_CNOT(state, 0, 1);
+
+    for (uint32_t lane = 0; lane < BITSLICE_LANES; lane++) {
+        uint8_t a = lane & 1, b = (lane >> 1) & 1;
+        assert(qubit_bitsliced_get_lane(state, lane, 2) == (a & b));
+        assert(qubit_bitsliced_get_lane(state, lane, 1) == (a ^ b));
+        assert(qubit_bitsliced_get_lane(state, lane, 0) == a);
+    }
+    printf("CCNOT/CNOT evaluated across all %d lanes in one pass\n", BITSLICE_LANES);
+
+    // NOT and SWAP on whole slices
+    uint64_t slice[BITSLICE_WORDS];
+    qubit_NOT(state, 0);
+    qubit_SWAP(state, 0, 2);
+    qubit_bitsliced_store(state, 2, slice);
+    for (uint32_t w = 0; w < BITSLICE_WORDS; w++) {
+        assert(slice[w] == 0x5555555555555555ULL);  // NOT a
+    }
+
+    // Lane 0 is what the generic read API reports
+    qubit_bitsliced_load(state, 1, (uint64_t[BITSLICE_WORDS]){1});
+    assert(qubit_read(state, 1) == 1);
+    assert(qubit_bitsliced_get_lane(state, 1, 1) == 0);
+
+    qubit_free(state);
+
+    printf("✓ Bit-sliced backend works correctly\n");
+}
+
+#else
+
+// ============================================================================
+// Test Fixed-Backend Build
+// ============================================================================
+
+void test_fixed_backend() {
+    printf("\n=== Testing Fixed-Backend Build ===\n");
+
+    // Every request resolves to the one linked backend
+    Qubit_State* state = qubit_init(8, QUBIT_BACKEND_BITSLICED);
+    assert(state != NULL);
+    assert(state->backend_type == MOOP_FIXED_BACKEND);
+    printf("Backend: %s\n", qubit_backend_name(state));
+
+    qubit_NOT(state, 0);
+    qubit_CNOT(state, 0, 1);
+    qubit_CCNOT(state, 0, 1, 2);
+    qubit_SWAP(state, 2, 3);
+    assert(qubit_read(state, 2) == 0 && qubit_read(state, 3) == 1);
+
+    qubit_free(state);
+
+    printf("✓ Fixed-backend build works correctly\n");
+}
+
+#endif
+
 // ============================================================================
 // Test Quantum Simulator Backend (if available)
 // ============================================================================
@@ -115,6 +266,541 @@ void test_quantum_superposition() {
     qubit_free(state);
 }
 
+void test_simulator_fusion() {
+    printf("\n=== Testing Simulator Gate Fusion ===\n");
+
+    // Distinct amplitudes, so any misplaced basis state shows up
+    const uint32_t n = 10;
+    Qubit_State* fused = qubit_init(n, QUBIT_BACKEND_SIMULATOR);
+    Qubit_State* plain = qubit_init(n, QUBIT_BACKEND_SIMULATOR);
+    quantum_simulator_set_fusion(plain, false);
+    Quantum_Simulator_State* f = (Quantum_Simulator_State*)fused->backend_data;
+    Quantum_Simulator_State* p = (Quantum_Simulator_State*)plain->backend_data;
+    for (uint64_t i = 0; i < f->state_size; i++) {
+        f->real_amplitudes[i] = p->real_amplitudes[i] = (double)i;
+        f->imag_amplitudes[i] = p->imag_amplitudes[i] = -(double)i;
+    }
+
+    // Includes repeated operands (CNOT a a, SWAP a a, CCNOT a b a)
+    srand(7);
+    const uint32_t gates = 2000;
+    for (uint32_t i = 0; i < gates; i++) {
+        uint8_t a = rand() % n, b = rand() % n, c = rand() % n;
+        Qubit_State* states[2] = {fused, plain};
+        uint32_t kind = rand() % 4;
+        for (uint32_t s = 0; s < 2; s++) {
+            switch (kind) {
+                case 0: qubit_CCNOT(states[s], a, b, c); break;
+                case 1: qubit_CNOT(states[s], a, b); break;
+                case 2: qubit_NOT(states[s], a); break;
+                case 3: qubit_SWAP(states[s], a, b); break;
+            }
+        }
+    }
+    quantum_simulator_flush(fused);
+    for (uint64_t i = 0; i < f->state_size; i++) {
+        assert(f->real_amplitudes[i] == p->real_amplitudes[i]);
+        assert(f->imag_amplitudes[i] == p->imag_amplitudes[i]);
+    }
+    printf("%u random gates in %llu sweeps (unfused: %llu)\n", gates,
+           (unsigned long long)f->sweeps, (unsigned long long)p->sweeps);
+    assert(f->sweeps < p->sweeps / 2);
+
+    // A run that composes to the identity costs no sweep at all
+    uint64_t sweeps = f->sweeps;
+    qubit_NOT(fused, 3);
+    qubit_CNOT(fused, 3, 4);
+    qubit_CNOT(fused, 3, 4);
+    qubit_NOT(fused, 3);
+    quantum_simulator_flush(fused);
+    assert(f->sweeps == sweeps);
+
+    // Queued gates are applied before a copy or a measurement
+    qubit_NOT(fused, 0);
+    Qubit_State* copy = qubit_clone(fused);
+    Quantum_Simulator_State* c = (Quantum_Simulator_State*)copy->backend_data;
+    assert(f->pending_count == 0 && c->pending_count == 0);
+    assert(c->real_amplitudes[0] == f->real_amplitudes[0]);
+    qubit_free(copy);
+
+    Qubit_State* basis = qubit_init(3, QUBIT_BACKEND_SIMULATOR);
+    qubit_NOT(basis, 1);
+    qubit_CNOT(basis, 1, 2);
+    assert(qubit_measure(basis, 2) == 1);
+    qubit_free(basis);
+
+    printf("✓ Fused gate runs match gate-by-gate sweeps\n");
+
+    qubit_free(fused);
+    qubit_free(plain);
+}
+
+void test_simulator_threads() {
+    printf("\n=== Testing Multithreaded Simulator Sweeps ===\n");
+
+    // Large enough that every sweep is split across the pool
+    const uint32_t n = 18;
+    Qubit_State* threaded = qubit_init(n, QUBIT_BACKEND_SIMULATOR);
+    Qubit_State* single = qubit_init(n, QUBIT_BACKEND_SIMULATOR);
+    quantum_simulator_set_threads(threaded, 4);
+    Quantum_Simulator_State* t = (Quantum_Simulator_State*)threaded->backend_data;
+    Quantum_Simulator_State* s = (Quantum_Simulator_State*)single->backend_data;
+    assert(t->threads == 4 && s->threads == 1);
+    for (uint64_t i = 0; i < t->state_size; i++) {
+        t->real_amplitudes[i] = s->real_amplitudes[i] = 1.0 + (double)(i % 97);
+        t->imag_amplitudes[i] = s->imag_amplitudes[i] = (double)(i % 13);
+    }
+
+    // Fused runs first, then single-gate sweeps
+    srand(11);
+    for (uint32_t i = 0; i < 400; i++) {
+        if (i == 200) {
+            quantum_simulator_set_fusion(threaded, false);
+            quantum_simulator_set_fusion(single, false);
+        }
+        uint8_t a = rand() % n, b = rand() % n, c = rand() % n;
+        Qubit_State* states[2] = {threaded, single};
+        uint32_t kind = rand() % 4;
+        for (uint32_t k = 0; k < 2; k++) {
+            switch (kind) {
+                case 0: qubit_CCNOT(states[k], a, b, c); break;
+                case 1: qubit_CNOT(states[k], a, b); break;
+                case 2: qubit_NOT(states[k], a); break;
+                case 3: qubit_SWAP(states[k], a, b); break;
+            }
+        }
+    }
+    for (uint64_t i = 0; i < t->state_size; i++) {
+        assert(t->real_amplitudes[i] == s->real_amplitudes[i]);
+        assert(t->imag_amplitudes[i] == s->imag_amplitudes[i]);
+    }
+
+    // Measurement: same outcome for the same random draw, and the
+    // collapsed, renormalized states agree
+    for (uint8_t q = 0; q < n; q += 5) {
+        srand(100 + q);
+        uint8_t outcome = qubit_measure(threaded, q);
+        srand(100 + q);
+        assert(qubit_measure(single, q) == outcome);
+    }
+    double norm = 0.0;
+    for (uint64_t i = 0; i < t->state_size; i++) {
+        assert(fabs(t->real_amplitudes[i] - s->real_amplitudes[i]) < 1e-12);
+        assert(fabs(t->imag_amplitudes[i] - s->imag_amplitudes[i]) < 1e-12);
+        norm += t->real_amplitudes[i] * t->real_amplitudes[i] +
+                t->imag_amplitudes[i] * t->imag_amplitudes[i];
+    }
+    assert(fabs(norm - 1.0) < 1e-9);
+
+    Qubit_State* copy = qubit_clone(threaded);
+    assert(((Quantum_Simulator_State*)copy->backend_data)->threads == 4);
+    qubit_free(copy);
+
+    printf("✓ 4-thread sweeps match the single-threaded statevector\n");
+
+    qubit_free(threaded);
+    qubit_free(single);
+}
+
+void test_simulator_layouts() {
+    printf("\n=== Testing Interleaved Amplitude Layout ===\n");
+
+    // 18 qubits: the interleaved buffer (4 MiB) takes the huge-page path
+    const uint32_t n = 18;
+    Qubit_State* split = qubit_init(n, QUBIT_BACKEND_SIMULATOR);
+    Qubit_State* pairs = qubit_init(n, QUBIT_BACKEND_SIMULATOR);
+    assert(quantum_simulator_set_layout(pairs, SIM_LAYOUT_INTERLEAVED));
+    Quantum_Simulator_State* q = (Quantum_Simulator_State*)pairs->backend_data;
+    assert(q->layout == SIM_LAYOUT_INTERLEAVED && q->real_amplitudes == NULL);
+    assert((uintptr_t)q->amplitudes % (2u << 20) == 0);
+    assert((uintptr_t)((Quantum_Simulator_State*)split->backend_data)->real_amplitudes % 64 == 0);
+
+    // Conversion keeps |0...0⟩
+    double re, im;
+    quantum_simulator_get_amplitude(pairs, 0, &re, &im);
+    assert(re == 1.0 && im == 0.0);
+
+    for (uint64_t i = 0; i < q->state_size; i++) {
+        quantum_simulator_set_amplitude(split, i, 1.0 + (double)(i % 89), (double)(i % 7));
+        quantum_simulator_set_amplitude(pairs, i, 1.0 + (double)(i % 89), (double)(i % 7));
+    }
+    quantum_simulator_set_threads(pairs, 3);
+
+    // Fused, then unfused gates, then measurements
+    srand(5);
+    for (uint32_t i = 0; i < 300; i++) {
+        if (i == 150) {
+            quantum_simulator_set_fusion(split, false);
+            quantum_simulator_set_fusion(pairs, false);
+        }
+        uint8_t a = rand() % n, b = rand() % n, c = rand() % n;
+        Qubit_State* states[2] = {split, pairs};
+        uint32_t kind = rand() % 4;
+        for (uint32_t k = 0; k < 2; k++) {
+            switch (kind) {
+                case 0: qubit_CCNOT(states[k], a, b, c); break;
+                case 1: qubit_CNOT(states[k], a, b); break;
+                case 2: qubit_NOT(states[k], a); break;
+                case 3: qubit_SWAP(states[k], a, b); break;
+            }
+        }
+    }
+    for (uint8_t b = 1; b < n; b += 6) {
+        srand(40 + b);
+        uint8_t outcome = qubit_measure(split, b);
+        srand(40 + b);
+        assert(qubit_measure(pairs, b) == outcome);
+    }
+    for (uint64_t i = 0; i < q->state_size; i++) {
+        double sr, si, pr, pi;
+        quantum_simulator_get_amplitude(split, i, &sr, &si);
+        quantum_simulator_get_amplitude(pairs, i, &pr, &pi);
+        assert(fabs(sr - pr) < 1e-12 && fabs(si - pi) < 1e-12);
+    }
+
+    // Copies across layouts and clones keep the amplitudes and the layout
+    Qubit_State* copy = qubit_init(n, QUBIT_BACKEND_SIMULATOR);
+    assert(qubit_copy(copy, pairs));
+    Qubit_State* clone = qubit_clone(pairs);
+    assert(((Quantum_Simulator_State*)clone->backend_data)->layout == SIM_LAYOUT_INTERLEAVED);
+    assert(quantum_simulator_set_layout(pairs, SIM_LAYOUT_SPLIT));
+    for (uint64_t i = 0; i < q->state_size; i += 97) {
+        double a_re, a_im, b_re, b_im, c_re, c_im;
+        quantum_simulator_get_amplitude(pairs, i, &a_re, &a_im);
+        quantum_simulator_get_amplitude(copy, i, &b_re, &b_im);
+        quantum_simulator_get_amplitude(clone, i, &c_re, &c_im);
+        assert(a_re == b_re && a_im == b_im && a_re == c_re && a_im == c_im);
+    }
+    qubit_free(copy);
+    qubit_free(clone);
+
+    printf("✓ Interleaved and split layouts evolve identically\n");
+
+    qubit_free(split);
+    qubit_free(pairs);
+}
+
+void test_simulator_measure_qubits() {
+    printf("\n=== Testing Fused Multi-Qubit Measurement ===\n");
+
+    // (|000⟩ + |111⟩ + |010⟩ + |101⟩) / 2 on qubits 0, 1, 2 of 12: qubits 0
+    // and 2 always agree, qubit 1 is independent of them
+    const uint32_t n = 12;
+    uint32_t agree = 0, ones = 0;
+    const uint32_t trials = 400;
+    srand(3);
+    for (uint32_t trial = 0; trial < trials; trial++) {
+        Qubit_State* state = qubit_init(n, QUBIT_BACKEND_SIMULATOR);
+        quantum_simulator_set_layout(state, trial % 2 ? SIM_LAYOUT_INTERLEAVED : SIM_LAYOUT_SPLIT);
+        const uint64_t basis[4] = {0x0, 0x7, 0x2, 0x5};
+        quantum_simulator_set_amplitude(state, 0, 0.0, 0.0);
+        for (uint32_t k = 0; k < 4; k++) quantum_simulator_set_amplitude(state, basis[k], 0.5, 0.0);
+
+        // Qubit 2 listed twice, and an untouched qubit that must read 0
+        const uint8_t qubits[5] = {2, 0, 9, 1, 2};
+        uint8_t out[5];
+        quantum_simulator_measure_qubits(state, qubits, 5, out);
+        assert(out[0] == out[1] && out[0] == out[4] && out[2] == 0);
+        agree += out[0] == out[1];
+        ones += out[3];
+
+        // Collapsed onto the sampled basis state with unit norm
+        uint64_t index = (uint64_t)out[1] | (uint64_t)out[3] << 1 | (uint64_t)out[0] << 2;
+        double re, im;
+        quantum_simulator_get_amplitude(state, index, &re, &im);
+        assert(fabs(re - 1.0) < 1e-12 && im == 0.0);
+        assert(qubit_measure(state, 1) == out[3]);
+        qubit_free(state);
+    }
+    printf("qubit 1 measured 1 in %u of %u trials\n", ones, trials);
+    assert(agree == trials);
+    assert(ones > trials / 2 - 60 && ones < trials / 2 + 60);
+
+    // Single-qubit measure keeps relative amplitudes: measuring qubit 3 of
+    // (|0⟩ + |1⟩ + |8⟩) / √3 as 0 leaves (|0⟩ + |1⟩) / √2
+    for (uint32_t attempt = 0; attempt < 50; attempt++) {
+        Qubit_State* state = qubit_init(4, QUBIT_BACKEND_SIMULATOR);
+        double a = 1.0 / sqrt(3.0);
+        quantum_simulator_set_amplitude(state, 0, a, 0.0);
+        quantum_simulator_set_amplitude(state, 1, 0.0, a);
+        quantum_simulator_set_amplitude(state, 8, a, 0.0);
+        uint8_t outcome = qubit_measure(state, 3);
+        double re, im;
+        quantum_simulator_get_amplitude(state, 1, &re, &im);
+        assert(fabs(im - (outcome ? 0.0 : sqrt(0.5))) < 1e-12 && re == 0.0);
+        qubit_free(state);
+    }
+
+    printf("✓ Joint measurement samples and collapses in two sweeps\n");
+}
+
+// Marginal P(qubit = 1) straight from the amplitudes
+static double brute_probability(Qubit_State* state, uint8_t qubit) {
+    const Quantum_Simulator_State* q = state->backend_data;
+    double one = 0.0, total = 0.0;
+    for (uint64_t i = 0; i < q->state_size; i++) {
+        double re, im;
+        quantum_simulator_get_amplitude(state, i, &re, &im);
+        total += re * re + im * im;
+        if ((i >> qubit) & 1) one += re * re + im * im;
+    }
+    return one / total;
+}
+
+void test_simulator_probability() {
+    printf("\n=== Testing Non-Collapsing Probability and Sampling ===\n");
+
+    // A spread-out superposition on 11 qubits (blocks of 256 plus high
+    // qubits), then a random gate stream: the cached marginals must track
+    // it, with and without fusion and in both layouts
+    const uint32_t n = 11;
+    for (uint32_t variant = 0; variant < 3; variant++) {
+        Qubit_State* state = qubit_init(n, QUBIT_BACKEND_SIMULATOR);
+        if (variant == 1) quantum_simulator_set_fusion(state, false);
+        if (variant == 2) quantum_simulator_set_layout(state, SIM_LAYOUT_INTERLEAVED);
+        uint32_t seed = 11 + variant;
+        for (uint64_t i = 0; i < (1u << n); i++) {
+            seed = seed * 1103515245u + 12345u;
+            double re = (double)(seed >> 16 & 0xFF) / 256.0;
+            quantum_simulator_set_amplitude(state, i, re, (i % 3) ? 0.0 : re / 2);
+        }
+
+        srand(200 + variant);
+        for (uint32_t g = 0; g < 300; g++) {
+            uint8_t a = rand() % n, b = (a + 1 + rand() % (n - 1)) % n;
+            uint8_t c = (b + 1) % n == a ? (b + 2) % n : (b + 1) % n;
+            switch (rand() % 4) {
+                case 0: qubit_CCNOT(state, a, b, c); break;
+                case 1: qubit_CNOT(state, a, b); break;
+                case 2: qubit_NOT(state, a); break;
+                case 3: qubit_SWAP(state, a, b); break;
+            }
+            if (g % 37 == 0) {
+                for (uint8_t q = 0; q < n; q++) {
+                    assert(fabs(qubit_probability(state, q) - brute_probability(state, q)) < 1e-12);
+                }
+            }
+        }
+        qubit_free(state);
+    }
+    printf("Cached marginals match the amplitudes through 300 random gates\n");
+
+    // On basis states every control is certain: reads follow the classical
+    // backend without a single sweep, the gates stay queued
+    Qubit_State* basis_state = qubit_init(n, QUBIT_BACKEND_SIMULATOR);
+    Qubit_State* reference = qubit_init(n, QUBIT_BACKEND_CLASSICAL);
+    const Quantum_Simulator_State* bq = basis_state->backend_data;
+    assert(qubit_read(basis_state, 0) == 0);  // Builds the cache
+    srand(77);
+    for (uint32_t g = 0; g < 500; g++) {
+        uint8_t a = rand() % n, b = (a + 1 + rand() % (n - 1)) % n;
+        uint8_t c = (b + 1) % n == a ? (b + 2) % n : (b + 1) % n;
+        switch (rand() % 4) {
+            case 0: qubit_CCNOT(basis_state, a, b, c); qubit_CCNOT(reference, a, b, c); break;
+            case 1: qubit_CNOT(basis_state, a, b); qubit_CNOT(reference, a, b); break;
+            case 2: qubit_NOT(basis_state, a); qubit_NOT(reference, a); break;
+            case 3: qubit_SWAP(basis_state, a, b); qubit_SWAP(reference, a, b); break;
+        }
+        uint64_t sweeps = bq->sweeps;
+        uint32_t pending = bq->pending_count;
+        const uint8_t read[3] = {a, b, c};
+        for (uint32_t k = 0; k < 3; k++) {
+            assert(qubit_read(basis_state, read[k]) == qubit_read(reference, read[k]));
+            assert(qubit_probability(basis_state, read[k]) == qubit_read(reference, read[k]));
+        }
+        assert(bq->sweeps == sweeps && bq->pending_count == pending);
+    }
+    qubit_free(basis_state);
+    qubit_free(reference);
+    printf("500 gates on a basis state read back with no extra sweeps\n");
+
+    // (|0⟩ + |3⟩ + |5⟩ + |6⟩) / 2 on 12 qubits: reads and probabilities
+    // leave the amplitudes alone, and sampling draws from them
+    Qubit_State* state = qubit_init(12, QUBIT_BACKEND_SIMULATOR);
+    const uint64_t basis[4] = {0x0, 0x3, 0x5, 0x6};
+    quantum_simulator_set_amplitude(state, 0, 0.0, 0.0);
+    for (uint32_t k = 0; k < 4; k++) quantum_simulator_set_amplitude(state, basis[k], 0.5, 0.0);
+    qubit_NOT(state, 11);
+    qubit_SWAP(state, 11, 4);
+    assert(qubit_probability(state, 0) == 0.5 && qubit_read(state, 0) == 0);
+    assert(qubit_probability(state, 4) == 1.0 && qubit_read(state, 4) == 1);
+    assert(qubit_probability(state, 11) == 0.0 && qubit_read(state, 11) == 0);
+
+    enum { SHOTS = 4000 };
+    static uint64_t shots[SHOTS];
+    const uint8_t qubits[4] = {2, 0, 4, 1};
+    uint32_t counts[16] = {0};
+    srand(9);
+    assert(quantum_simulator_sample(state, qubits, 4, SHOTS, shots));
+    for (uint32_t s = 0; s < SHOTS; s++) counts[shots[s]]++;
+    // Pattern bits: qubit 2, qubit 0, qubit 4, qubit 1
+    const uint32_t expected[4] = {0x4, 0xE, 0x7, 0xD};
+    for (uint32_t k = 0; k < 4; k++) {
+        printf("pattern %X: %u shots\n", expected[k], counts[expected[k]]);
+        assert(counts[expected[k]] > SHOTS / 4 - 200 && counts[expected[k]] < SHOTS / 4 + 200);
+    }
+
+    // A single cached qubit samples from its marginal
+    assert(quantum_simulator_sample(state, qubits + 3, 1, SHOTS, shots));
+    uint32_t ones = 0;
+    for (uint32_t s = 0; s < SHOTS; s++) ones += (uint32_t)shots[s];
+    assert(ones > SHOTS / 2 - 200 && ones < SHOTS / 2 + 200);
+
+    for (uint32_t k = 0; k < 4; k++) {
+        double re, im;
+        quantum_simulator_get_amplitude(state, basis[k] | 0x10, &re, &im);
+        assert(re == 0.5 && im == 0.0);
+    }
+
+    // Measuring updates the cache: the measured qubit is then certain
+    uint8_t outcome = qubit_measure(state, 1);
+    assert(qubit_probability(state, 1) == outcome);
+    assert(fabs(qubit_probability(state, 0) - brute_probability(state, 0)) < 1e-12);
+    qubit_free(state);
+
+    printf("✓ Reads, probabilities and shots leave the state intact\n");
+}
+
+void test_sparse_backend() {
+    printf("\n=== Testing Sparse Simulator Backend ===\n");
+
+    // Same 40-term state and gate stream (repeated operands included) on
+    // the dense and sparse simulators: amplitudes, probabilities and
+    // measurements agree exactly
+    const uint32_t n = 12;
+    Qubit_State* dense = qubit_init(n, QUBIT_BACKEND_SIMULATOR);
+    Qubit_State* sparse = qubit_init(n, QUBIT_BACKEND_SPARSE);
+    assert(sparse != NULL && qubit_is_quantum(sparse));
+    printf("Backend: %s\n", qubit_backend_name(sparse));
+    quantum_simulator_set_amplitude(dense, 0, 0.0, 0.0);
+    assert(sparse_simulator_set_amplitude(sparse, 0, 0.0, 0.0));
+    assert(sparse_simulator_count(sparse) == 0);
+    srand(5);
+    for (uint32_t k = 0; k < 40; k++) {
+        uint64_t index = (uint64_t)rand() % (1u << n);
+        double re = (double)(rand() % 100) / 100.0 + 0.01, im = (double)(rand() % 7) / 10.0;
+        quantum_simulator_set_amplitude(dense, index, re, im);
+        assert(sparse_simulator_set_amplitude(sparse, index, re, im));
+    }
+    for (uint32_t g = 0; g < 2000; g++) {
+        uint8_t a = rand() % n, b = rand() % n, c = rand() % n;
+        Qubit_State* states[2] = {dense, sparse};
+        uint32_t kind = rand() % 4;
+        for (uint32_t k = 0; k < 2; k++) {
+            switch (kind) {
+                case 0: qubit_CCNOT(states[k], a, b, c); break;
+                case 1: qubit_CNOT(states[k], a, b); break;
+                case 2: qubit_NOT(states[k], a); break;
+                case 3: qubit_SWAP(states[k], a, b); break;
+            }
+        }
+    }
+    uint32_t nonzero = 0;
+    for (uint64_t i = 0; i < (1u << n); i++) {
+        double dr, di, sr, si;
+        quantum_simulator_get_amplitude(dense, i, &dr, &di);
+        sparse_simulator_get_amplitude(sparse, i, &sr, &si);
+        assert(dr == sr && di == si);
+        nonzero += dr != 0.0 || di != 0.0;
+    }
+    assert(nonzero == sparse_simulator_count(sparse));
+    for (uint8_t q = 0; q < n; q++) {
+        assert(fabs(qubit_probability(dense, q) - qubit_probability(sparse, q)) < 1e-12);
+        assert(qubit_read(dense, q) == qubit_read(sparse, q));
+    }
+    for (uint8_t q = 0; q < n; q += 3) {
+        srand(300 + q);
+        uint8_t outcome = qubit_measure(dense, q);
+        srand(300 + q);
+        assert(qubit_measure(sparse, q) == outcome);
+    }
+    for (uint64_t i = 0; i < (1u << n); i++) {
+        double dr, di, sr, si;
+        quantum_simulator_get_amplitude(dense, i, &dr, &di);
+        sparse_simulator_get_amplitude(sparse, i, &sr, &si);
+        assert(fabs(dr - sr) < 1e-12 && fabs(di - si) < 1e-12);
+    }
+    printf("%u terms track the dense simulator through 2000 gates\n", nonzero);
+    qubit_free(dense);
+
+    // 64 qubits: three terms, each following its own classical register
+    const uint64_t terms[3] = {0x0ULL, 0x8000000000000005ULL, ~0ULL};
+    Qubit_State* wide = qubit_init(64, QUBIT_BACKEND_SPARSE);
+    Qubit_State* lanes[3];
+    sparse_simulator_set_amplitude(wide, 0, 0.0, 0.0);
+    for (uint32_t t = 0; t < 3; t++) {
+        sparse_simulator_set_amplitude(wide, terms[t], 1.0 / sqrt(3.0), 0.0);
+        lanes[t] = qubit_init(64, QUBIT_BACKEND_CLASSICAL);
+        for (uint8_t q = 0; q < 64; q++) {
+            if ((terms[t] >> q) & 1) qubit_NOT(lanes[t], q);
+        }
+    }
+    srand(64);
+    for (uint32_t g = 0; g < 3000; g++) {
+        uint8_t a = rand() % 64, b = (a + 1 + rand() % 63) % 64;
+        uint8_t c = (b + 1) % 64 == a ? (b + 2) % 64 : (b + 1) % 64;
+        uint32_t kind = rand() % 4;
+        for (uint32_t t = 0; t < 4; t++) {
+            Qubit_State* s = t < 3 ? lanes[t] : wide;
+            switch (kind) {
+                case 0: qubit_CCNOT(s, a, b, c); break;
+                case 1: qubit_CNOT(s, a, b); break;
+                case 2: qubit_NOT(s, a); break;
+                case 3: qubit_SWAP(s, a, b); break;
+            }
+        }
+    }
+    uint64_t final[3];
+    for (uint32_t t = 0; t < 3; t++) {
+        final[t] = 0;
+        for (uint8_t q = 0; q < 64; q++) final[t] |= (uint64_t)qubit_read(lanes[t], q) << q;
+        double re, im;
+        sparse_simulator_get_amplitude(wide, final[t], &re, &im);
+        assert(re == 1.0 / sqrt(3.0) && im == 0.0);
+        qubit_free(lanes[t]);
+    }
+    assert(sparse_simulator_count(wide) == 3);
+
+    // Clones diverge independently, copies bring them back
+    Qubit_State* clone = qubit_clone(wide);
+    qubit_NOT(clone, 63);
+    double re, im;
+    for (uint32_t t = 0; t < 3; t++) {
+        sparse_simulator_get_amplitude(clone, final[t] ^ (1ULL << 63), &re, &im);
+        assert(re == 1.0 / sqrt(3.0));
+    }
+    assert(qubit_copy(clone, wide));
+    for (uint32_t t = 0; t < 3; t++) {
+        sparse_simulator_get_amplitude(clone, final[t], &re, &im);
+        assert(re == 1.0 / sqrt(3.0));
+    }
+    qubit_free(clone);
+
+    // Measuring a qubit the terms disagree on drops the others, renormalized
+    uint8_t split = 0;
+    while (((final[0] >> split) & 1) == ((final[1] >> split) & 1) &&
+           ((final[0] >> split) & 1) == ((final[2] >> split) & 1)) {
+        split++;
+    }
+    uint8_t outcome = qubit_measure(wide, split);
+    double norm = 0.0;
+    uint32_t kept = 0;
+    for (uint32_t t = 0; t < 3; t++) {
+        sparse_simulator_get_amplitude(wide, final[t], &re, &im);
+        kept += ((final[t] >> split) & 1) == outcome;
+        assert((re != 0.0) == (((final[t] >> split) & 1) == outcome));
+        norm += re * re;
+    }
+    assert(sparse_simulator_count(wide) == kept && fabs(norm - 1.0) < 1e-12);
+    assert(qubit_probability(wide, split) == outcome);
+    qubit_free(wide);
+    qubit_free(sparse);
+
+    assert(qubit_init(65, QUBIT_BACKEND_SPARSE) == NULL);
+
+    printf("✓ Sparse backend runs 64-qubit registers as index rewrites\n");
+}
+
 #endif
 
 // ============================================================================
@@ -134,7 +820,7 @@ void test_backend_abstraction() {
     }
 
 #ifdef ENABLE_QUANTUM_SIMULATOR
-    assert(count >= 2);  // Classical + Simulator
+    assert(count >= 3);  // Classical + Simulator + Sparse
 #else
     assert(count >= 1);  // Classical only
 #endif
@@ -171,10 +857,13 @@ void test_same_code_different_backends() {
 
     // Classical
     run_computation_on_backend(QUBIT_BACKEND_CLASSICAL, "Classical Backend");
+    run_computation_on_backend(QUBIT_BACKEND_PACKED, "Bit-Packed Backend");
+    run_computation_on_backend(QUBIT_BACKEND_BITSLICED, "Bit-Sliced Backend");
 
 #ifdef ENABLE_QUANTUM_SIMULATOR
     // Quantum simulator
     run_computation_on_backend(QUBIT_BACKEND_SIMULATOR, "Quantum Simulator");
+    run_computation_on_backend(QUBIT_BACKEND_SPARSE, "Sparse Simulator");
 #endif
 
     printf("✓ Same code runs on all backends\n");
@@ -191,10 +880,22 @@ int main(void) {
 
     test_backend_abstraction();
     test_classical_backend();
+#ifndef MOOP_FIXED_BACKEND
+    test_packed_backend();
+    test_bitsliced_backend();
+#else
+    test_fixed_backend();
+#endif
 
 #ifdef ENABLE_QUANTUM_SIMULATOR
     test_quantum_simulator_backend();
     test_quantum_superposition();
+    test_simulator_fusion();
+    test_simulator_threads();
+    test_simulator_layouts();
+    test_simulator_measure_qubits();
+    test_simulator_probability();
+    test_sparse_backend();
 #else
     printf("\n[INFO] Quantum simulator not enabled. To test quantum backend:\n");
     printf("       make clean && make CFLAGS=\"-DENABLE_QUANTUM_SIMULATOR\"\n");